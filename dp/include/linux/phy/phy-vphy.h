@@ -24,6 +24,55 @@
 #include "xvphy.h"
 
 struct phy;
+struct phy_configure_opts_dp;
+
+/* lanes the PRBS BER engine can measure */
+#define XVPHY_BER_MAX_LANES	4
+
+/**
+ * struct xvphy_ber_lane - PRBS BER statistics of a lane
+ * @bits: bits checked since the measurement started
+ * @errors: PRBS checker errors since the measurement started
+ * @sym_errors: symbol errors since the measurement started
+ * @last_err_cnt: last GT PRBS error counter value
+ * @last_sym_cnt: last symbol error counter value
+ * @saturated: the GT PRBS error counter saturated, @errors is a lower bound
+ */
+struct xvphy_ber_lane {
+	u64 bits;
+	u64 errors;
+	u64 sym_errors;
+	u32 last_err_cnt;
+	u16 last_sym_cnt;
+	bool saturated;
+};
+
+/**
+ * struct xvphy_ber - PRBS bit error rate measurement
+ * @lock: protects the fields below, taken before xvphy_mutex
+ * @work: samples the error counters periodically
+ * @pattern: PRBS pattern under test
+ * @lanes: lanes under test, one bit per lane
+ * @running: a measurement is in progress
+ * @start: time the measurement started
+ * @last: time of the last sample
+ * @lane: per lane statistics
+ */
+struct xvphy_ber {
+	struct mutex lock;
+	struct delayed_work work;
+	XVphy_PrbsPattern pattern;
+	u8 lanes;
+	bool running;
+	ktime_t start;
+	ktime_t last;
+	struct xvphy_ber_lane lane[XVPHY_BER_MAX_LANES];
+};
+
+/* room for the register image captured across system suspend */
+#define XVPHY_PM_MAX_AXI_REGS	32
+#define XVPHY_PM_MAX_DRP_WORDS	128
+
 /**
  *  * struct xvphy_dev - representation of a Xilinx Video PHY
  *   * @dev: pointer to device
@@ -42,10 +91,35 @@ struct xvphy_dev {
         /* AXI Lite clock drives the clock detector */
         struct clk *axi_lite_clk;
 	struct clk *drp_clk;
+	/* GT reference clock from the FMC IDT synthesizer, optional */
+	struct clk *refclk;
 	struct clk *vid_phy_rx_axi4s_aclk;
         /* NI-DRU clock input */
         struct clk *clkp;
         struct regmap *regmap;
+	/* AXI-lite and DRP image saved on suspend, replayed on resume */
+	u32 pm_axi[XVPHY_PM_MAX_AXI_REGS];
+	u16 pm_drp[XVPHY_PM_MAX_DRP_WORDS];
+	bool pm_image_valid;
+	bool pm_replay_pending;
+	/*
+	 * lanes powered on by consumers plus a running BER measurement,
+	 * indexed by XVphy_DirectionType
+	 */
+	unsigned int pm_users[2];
+	/*
+	 * set per direction by its first phy_power_on(); until then consumers
+	 * drive that direction directly, so it is not gated, and the device is
+	 * not runtime suspended until every configured direction is gated
+	 */
+	bool pm_gating[2];
+	/*
+	 * lane count set through phy_configure() per direction, 0 for all;
+	 * the channels above it are held in power down while gating
+	 */
+	u8 pm_lanes[2];
+	/* PRBS bit error rate measurement, see the prbs_* attributes */
+	struct xvphy_ber ber;
 };
 
 
@@ -65,5 +139,11 @@ extern XVphy *xvphy_get_xvphy(struct phy *phy);
 extern void xvphy_mutex_lock(struct phy *phy);
 extern void xvphy_mutex_unlock(struct phy *phy);
 extern int xvphy_do_something(struct phy *phy);
+extern int xvphy_dp_plan_link(struct phy *phy,
+			      const XVidC_VideoStream *stream,
+			      u64 pixel_clk_hz, bool mst,
+			      const u32 *sink_rates,
+			      unsigned int num_sink_rates,
+			      struct phy_configure_opts_dp *dp);
 
 #endif /* _PHY_VPHY_H_ */
@@ -447,6 +447,9 @@ typedef struct {
 	};
 	u16 Cdr[5];
 	u8 IsLowerBand;
+	u8 SdmEnable;		/**< QPLL fractional-N feedback mode. */
+	u32 SdmData;		/**< Fractional part of the QPLL feedback
+					divider, in units of 2^-24. */
 } XVphy_PllParam;
 
 /**
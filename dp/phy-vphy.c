@@ -37,17 +37,23 @@
 #include <linux/regmap.h>
 #include <linux/phy/phy.h>
 #include <linux/platform_device.h>
+#include <linux/pm_runtime.h>
 #include <linux/delay.h>
 #include <dt-bindings/phy/phy.h>
 #include <linux/list.h>
 #include <linux/slab.h>
+#include <linux/string.h>
 #include <linux/interrupt.h>
+#include <linux/int_sqrt.h>
+#include <linux/math64.h>
+#include <linux/workqueue.h>
 
 #include "linux/phy/phy-vphy.h"
 
 /* baseline driver includes */
 #include "phy-xilinx-vphy/xvphy.h"
 #include "phy-xilinx-vphy/xvphy_i.h"
+#include "phy-xilinx-vphy/xvphy_gt.h"
 
 /* common RX/TX */
 #include "phy-xilinx-vphy/xdebug.h"
@@ -97,6 +103,12 @@
 #define XVPHY_GTHE4_PREEMP_DP_L2    0x16
 #define XVPHY_GTHE4_PREEMP_DP_L3    0x1D
 
+#define XVPHY_AUTOSUSPEND_DELAY_MS	2000
+
+/* DP and eDP line rates accepted by phy_configure, in Mbps */
+#define XVPHY_DP_LINK_RATE_MIN	1620
+#define XVPHY_DP_LINK_RATE_MAX	8100
+
 #define XPAR_XDP_0_GT_DATAWIDTH 2
 #define XVPHY_DRP_REF_CLK_HZ	40000000
 #define SET_RX_TO_2BYTE		\
@@ -273,61 +285,221 @@ EXPORT_SYMBOL_GPL(xvphy_mutex_lock);
 ******************************************************************************/
 void PLLRefClkSel (XVphy *InstancePtr, u32 link_rate) {
 
-	switch (link_rate) {
-	case 1620:
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-		ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
+	u64 LineRateHz = XVPHY_DP_LINK_RATE_HZ_270GBPS;
+
+	/* Any DP or eDP rate in range, HBR otherwise */
+	if ((link_rate >= XVPHY_DP_LINK_RATE_MIN) &&
+	    (link_rate <= XVPHY_DP_LINK_RATE_MAX))
+		LineRateHz = (u64)link_rate * 1000000;
+
+	XVphy_CfgQuadRefClkFreq(InstancePtr, 0,
 			//DP159_FORWARDED_CLK,
 			ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
-				  XVPHY_DP_LINK_RATE_HZ_162GBPS);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN1,
-				  XVPHY_DP_LINK_RATE_HZ_162GBPS);
-		break;
-	case 5400:
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-		ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-		//	DP159_FORWARDED_CLK,
-		ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
-				  XVPHY_DP_LINK_RATE_HZ_540GBPS);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN1,
-				  XVPHY_DP_LINK_RATE_HZ_540GBPS);
-		break;
-	case 8100:
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-		ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-	//	DP159_FORWARDED_CLK,
-	ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
-				  XVPHY_DP_LINK_RATE_HZ_810GBPS);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN1,
-				  XVPHY_DP_LINK_RATE_HZ_810GBPS);
-		break;
-	default:
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0, 
-		ONBOARD_REF_CLK,
-					XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgQuadRefClkFreq(InstancePtr, 0,
-//					DP159_FORWARDED_CLK, XVPHY_DP_REF_CLK_FREQ_HZ_135);
-					//DP159_FORWARDED_CLK, XVPHY_DP_REF_CLK_FREQ_HZ_270);
-					ONBOARD_REF_CLK, XVPHY_DP_REF_CLK_FREQ_HZ_270);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
-				  XVPHY_DP_LINK_RATE_HZ_270GBPS);
-		XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN1,
-				  XVPHY_DP_LINK_RATE_HZ_270GBPS);
-		break;
+				XVPHY_DP_REF_CLK_FREQ_HZ_270);
+	XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA, LineRateHz);
+	XVphy_CfgLineRate(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN1, LineRateHz);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function selects the TX user configuration for a line rate
+*
+* @param    InstancePtr is a pointer to the Video PHY instance.
+* @param    link_rate is the line rate in Mbps.
+* @param    cfg is filled with the configuration to use.
+*
+* @return   XST_SUCCESS if a TX PLL reaches the line rate,
+*           XST_FAILURE otherwise.
+*
+* @note     The standard DP rates use their PHY_User_Config_Table entry.
+*           Other rates, such as the eDP intermediate ones, are derived
+*           from the HBR entry and move to the QPLL1, which has a
+*           fractional-N mode, when the CPLL cannot reach them.
+*
+******************************************************************************/
+static u32 xvphy_dp_tx_config(XVphy *InstancePtr, u32 link_rate,
+			      XVphy_User_Config *cfg)
+{
+	/* HBR entries of the CPLL and the QPLL1 */
+	static const u8 hbr_idx[] = { 1, 4 };
+	XVphy_PllType tx_pll = (is_TX_CPLL) ? XVPHY_PLL_TYPE_CPLL :
+					      XVPHY_PLL_TYPE_QPLL1;
+	XVphy_PllSolution Sol;
+	u64 RefClkHz;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(PHY_User_Config_Table); i++) {
+		if ((PHY_User_Config_Table[i].LineRate == link_rate) &&
+		    (PHY_User_Config_Table[i].TxPLL == tx_pll)) {
+			*cfg = PHY_User_Config_Table[i];
+			return XST_SUCCESS;
+		}
+	}
+
+	if ((link_rate < XVPHY_DP_LINK_RATE_MIN) ||
+	    (link_rate > XVPHY_DP_LINK_RATE_MAX))
+		return XST_FAILURE;
+
+	for (i = (is_TX_CPLL) ? 0 : 1; i < ARRAY_SIZE(hbr_idx); i++) {
+		*cfg = PHY_User_Config_Table[hbr_idx[i]];
+		cfg->LineRate = link_rate;
+		cfg->LineRateHz = (u64)link_rate * 1000000;
+		RefClkHz = (cfg->TxPLL == XVPHY_PLL_TYPE_CPLL) ?
+			   cfg->CPLLRefClkFreqHz : cfg->QPLLRefClkFreqHz;
+		if (XVphy_PllSolve(InstancePtr, 0, cfg->TxChId, RefClkHz,
+				   cfg->LineRateHz, 0, &Sol) == XST_SUCCESS)
+			return XST_SUCCESS;
+	}
+
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks whether a lane direction can run at a line rate
+*
+* @param    InstancePtr is a pointer to the Video PHY instance.
+* @param    link_rate is the line rate in Mbps.
+* @param    tx is true for the TX direction.
+*
+* @return   true if the line rate is supported, false otherwise.
+*
+* @note     RX always runs from the CPLL, which has no fractional-N mode.
+*
+******************************************************************************/
+static bool xvphy_dp_link_rate_valid(XVphy *InstancePtr, u32 link_rate,
+				     bool tx)
+{
+	XVphy_User_Config cfg;
+	XVphy_PllSolution Sol;
+
+	if (tx)
+		return xvphy_dp_tx_config(InstancePtr, link_rate, &cfg) ==
+		       XST_SUCCESS;
+
+	if ((link_rate < XVPHY_DP_LINK_RATE_MIN) ||
+	    (link_rate > XVPHY_DP_LINK_RATE_MAX))
+		return false;
+
+	return XVphy_PllSolve(InstancePtr, 0, XVPHY_CHANNEL_ID_CH1,
+			      XVPHY_DP_REF_CLK_FREQ_HZ_270,
+			      (u64)link_rate * 1000000, 0, &Sol) == XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks whether a lane direction can run a lane count
+*
+* @param    InstancePtr is a pointer to the Video PHY instance.
+* @param    lanes is the number of lanes.
+* @param    tx is true for the TX direction.
+*
+* @return   true if the lane count is supported, false otherwise.
+*
+* @note     None.
+*
+******************************************************************************/
+static bool xvphy_dp_lanes_valid(XVphy *InstancePtr, u32 lanes, bool tx)
+{
+	u8 channels = tx ? InstancePtr->Config.TxChannels :
+			   InstancePtr->Config.RxChannels;
+
+	return (lanes == 1 || lanes == 2 || lanes == 4) && lanes <= channels;
+}
+
+/* DP and eDP line rates in Mbps known to the link planner */
+static const struct {
+	u32 mbps;
+	bool edp;
+} xvphy_dp_plan_rates[] = {
+	{ 1620, false }, { 2160, true }, { 2430, true }, { 2700, false },
+	{ 3240, true }, { 4320, true }, { 5400, false }, { 8100, false },
+};
+
+/* a rate is offered if the sink lists it, or is a standard DP rate */
+static bool xvphy_dp_plan_rate_offered(int i, const u32 *sink_rates,
+				       unsigned int num_sink_rates)
+{
+	unsigned int j;
+
+	if (!sink_rates)
+		return !xvphy_dp_plan_rates[i].edp;
+
+	for (j = 0; j < num_sink_rates; j++)
+		if (sink_rates[j] == xvphy_dp_plan_rates[i].mbps)
+			return true;
+
+	return false;
+}
+
+/**
+ * xvphy_dp_plan_link - choose the smallest DP link that carries a stream
+ * @phy: PHY lane the link is driven from
+ * @stream: video stream to carry
+ * @pixel_clk_hz: pixel clock of the stream, 0 to derive it from @stream
+ * @mst: the stream is carried in MST time slots
+ * @sink_rates: link rates (Mbps) of an eDP 1.4 sink's SUPPORTED_LINK_RATES
+ *              table, NULL for a sink that only trains at RBR/HBR/HBR2/HBR3
+ * @num_sink_rates: number of entries in @sink_rates
+ * @dp: on entry a non-zero link_rate (Mbps) and lanes bound the search, e.g.
+ *      to the sink capabilities; on success they hold the planned link and
+ *      set_rate and set_lanes are raised so phy_configure() applies it, the
+ *      channels above the lane count being powered down once the direction
+ *      is gated by phy_power_on()
+ *
+ * Only the rates the sink supports and the lane direction can reach are
+ * offered to the planner; the eDP intermediate rates need @sink_rates.
+ *
+ * Return: 0 on success, -EINVAL if the stream does not fit
+ */
+int xvphy_dp_plan_link(struct phy *phy, const XVidC_VideoStream *stream,
+		       u64 pixel_clk_hz, bool mst, const u32 *sink_rates,
+		       unsigned int num_sink_rates,
+		       struct phy_configure_opts_dp *dp)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	XVphy *InstancePtr = &vphy_lane->vphydev->xvphy;
+	u64 rates_hz[ARRAY_SIZE(xvphy_dp_plan_rates)];
+	XVphy_DpLinkCaps caps = { .LinkRatesHz = rates_hz, .IsMst = mst };
+	XVphy_DpLinkPlan plan;
+	u8 channels;
+	int i;
+
+	channels = vphy_lane->direction ? InstancePtr->Config.TxChannels :
+					  InstancePtr->Config.RxChannels;
+	caps.MaxLaneCount = dp->lanes ? min_t(u32, dp->lanes, channels) :
+					channels;
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_dp_plan_rates); i++) {
+		if (dp->link_rate && xvphy_dp_plan_rates[i].mbps > dp->link_rate)
+			break;
+		if (!xvphy_dp_plan_rate_offered(i, sink_rates, num_sink_rates) ||
+		    !xvphy_dp_link_rate_valid(InstancePtr,
+					      xvphy_dp_plan_rates[i].mbps,
+					      vphy_lane->direction))
+			continue;
+		rates_hz[caps.NumLinkRates++] =
+			(u64)xvphy_dp_plan_rates[i].mbps * 1000000;
 	}
+
+	if (XVphy_DpPlanLink(stream, pixel_clk_hz, &caps, &plan) !=
+	    XST_SUCCESS)
+		return -EINVAL;
+
+	dp->link_rate = plan.LinkRateHz / 1000000;
+	dp->lanes = plan.LaneCount;
+	dp->set_rate = 1;
+	dp->set_lanes = 1;
+	dev_dbg(vphy_lane->vphydev->dev,
+		"planned %u Mbps x %u lanes for %llu of %llu bps\n",
+		dp->link_rate, dp->lanes, plan.StreamBps, plan.CapacityBps);
+
+	return 0;
 }
+EXPORT_SYMBOL_GPL(xvphy_dp_plan_link);
 /*****************************************************************************/
 /**
 *
@@ -344,6 +516,10 @@ void PLLRefClkSel (XVphy *InstancePtr, u32 link_rate) {
 void DpRxSs_LinkBandwidthHandler(u32 linkrate)
 {
 //	dev_dbg(vphydev->dev,"  DpRxSs_LinkBandwidthHandler \n");
+	if (pm_runtime_resume_and_get(vphydev->dev) < 0) {
+		dev_err(vphydev->dev, "failed to resume for RX line rate\n");
+		return;
+	}
 	/*Program Video PHY to requested line rate*/
 	PLLRefClkSel (&vphydev->xvphy,linkrate);
 	XVphy_ResetGtPll(&vphydev->xvphy, 0, XVPHY_CHANNEL_ID_CHA,
@@ -353,7 +529,8 @@ void DpRxSs_LinkBandwidthHandler(u32 linkrate)
 			    XVPHY_PLL_TYPE_QPLL1, XVPHY_PLL_TYPE_CPLL);
 	XVphy_ClkInitialize(&vphydev->xvphy, 0, XVPHY_CHANNEL_ID_CHA,
 			    XVPHY_DIR_RX);
-
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
 }
 
 /*****************************************************************************/
@@ -372,6 +549,10 @@ void DpRxSs_PllResetHandler(void)
 {
 	/* Issue resets to Video PHY - This API
 	 * called after line rate is programmed */
+	if (pm_runtime_resume_and_get(vphydev->dev) < 0) {
+		dev_err(vphydev->dev, "failed to resume for RX PLL reset\n");
+		return;
+	}
 	XVphy_BufgGtReset(&vphydev->xvphy, XVPHY_DIR_RX,(TRUE));
 	XVphy_ResetGtPll(&vphydev->xvphy, 0, XVPHY_CHANNEL_ID_CHA,
 			 XVPHY_DIR_RX,(TRUE));
@@ -383,7 +564,8 @@ void DpRxSs_PllResetHandler(void)
 			       XVPHY_DIR_RX);
 	XVphy_WaitForPllLock(&vphydev->xvphy, 0, XVPHY_CHANNEL_ID_CHA);
 	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
-	
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
 }
 EXPORT_SYMBOL(DpRxSs_PllResetHandler);
 /*****************************************************************************/
@@ -475,31 +657,24 @@ struct xvphy_dev *vphydev;
  * ******************************************************************************/
 u32 set_vphy(int LineRate_init_tx){
 
-
-        u32 Status=0;
+        XVphy_User_Config PHY_User_Config;
+        u32 Status;
 
 //	dev_dbg(vphydev->dev,"  set_vphy \n");
-        switch(LineRate_init_tx){
-                case 1620:
-                        Status = PHY_Configuration_Tx(&vphydev->xvphy,
-                                                PHY_User_Config_Table[(is_TX_CPLL)?0:3]);
-                        break;
-
-                case 2700:
-                        Status = PHY_Configuration_Tx(&vphydev->xvphy,
-                                                PHY_User_Config_Table[(is_TX_CPLL)?1:4]);
-                        break;
-
-                case 5400:
-                        Status = PHY_Configuration_Tx(&vphydev->xvphy,
-                                                PHY_User_Config_Table[(is_TX_CPLL)?2:5]);
-                        break;
-
-                case 8100:
-                        Status = PHY_Configuration_Tx(&vphydev->xvphy,
-                                                PHY_User_Config_Table[(is_TX_CPLL)?9:10]);
-                        break;
-        }
+	if (pm_runtime_resume_and_get(vphydev->dev) < 0) {
+		dev_err(vphydev->dev, "failed to resume for TX line rate\n");
+		return XST_FAILURE;
+	}
+	Status = xvphy_dp_tx_config(&vphydev->xvphy, LineRate_init_tx,
+				    &PHY_User_Config);
+	if (Status == XST_SUCCESS)
+		Status = PHY_Configuration_Tx(&vphydev->xvphy,
+					      PHY_User_Config);
+	else
+		dev_err(vphydev->dev, "unsupported TX line rate %d Mbps\n",
+			LineRate_init_tx);
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
 
         if (Status != XST_SUCCESS) {
                 printk ( "+++++++ vphy TX GT configuration encountered a failure +++++++ Sta     tus=%d\r\n",Status);
@@ -566,6 +741,10 @@ void xvphy_prbs_mode(u8 enable)
 	XVphy *InstancePtr = &vphydev->xvphy;
 	u32 DrpVal;
 
+	if (pm_runtime_resume_and_get(vphydev->dev) < 0) {
+		dev_err(vphydev->dev, "failed to resume for PRBS mode\n");
+		return;
+	}
 	if (enable) {
 		/* Enable PRBS Mode in Video PHY*/
 		DrpVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
@@ -594,6 +773,8 @@ void xvphy_prbs_mode(u8 enable)
 		XVphy_WriteReg(InstancePtr->Config.BaseAddr,
 			       XVPHY_RX_CONTROL_REG, DrpVal);
 	}
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
 }
 
 /**
@@ -694,6 +875,19 @@ EXPORT_SYMBOL_GPL(XVphy_IBufDsEnable);
 EXPORT_SYMBOL_GPL(XVphy_Clkout1OBufTdsEnable);
 EXPORT_SYMBOL_GPL(XVphy_IsBonded);
 
+/* interrupt types serviced by the threaded handler */
+#define XVPHY_DP_INTR_TYPES \
+	(XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE | \
+	 XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE | \
+	 XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK | \
+	 XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK | \
+	 XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE | \
+	 XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK | \
+	 XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE | \
+	 XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE | \
+	 XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT | \
+	 XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT)
+
 static irqreturn_t xvphy_irq_handler(int irq, void *dev_id)
 {
 	struct xvphy_dev *vphydev;
@@ -704,16 +898,7 @@ static irqreturn_t xvphy_irq_handler(int irq, void *dev_id)
 		return IRQ_NONE;
 
 	/* disable interrupts in the VPHY, they are re-enabled once serviced */
-	XVphy_IntrDisable(&vphydev->xvphy, XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE |
-			XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE |
-			XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK |
-			XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-			XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-			XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+	XVphy_IntrDisable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
 
 	return IRQ_WAKE_THREAD;
 }
@@ -739,16 +924,7 @@ static irqreturn_t xvphy_irq_thread(int irq, void *dev_id)
 	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
 
 	/* enable interrupt requesting in the VPHY */
-	XVphy_IntrEnable(&vphydev->xvphy, XVPHY_INTR_HANDLER_TYPE_TXRESET_DONE |
-		XVPHY_INTR_HANDLER_TYPE_RXRESET_DONE |
-		XVPHY_INTR_HANDLER_TYPE_CPLL_LOCK |
-		XVPHY_INTR_HANDLER_TYPE_QPLL0_LOCK |
-		XVPHY_INTR_HANDLER_TYPE_TXALIGN_DONE |
-		XVPHY_INTR_HANDLER_TYPE_QPLL1_LOCK |
-		XVPHY_INTR_HANDLER_TYPE_TX_CLKDET_FREQ_CHANGE |
-		XVPHY_INTR_HANDLER_TYPE_RX_CLKDET_FREQ_CHANGE |
-		XVPHY_INTR_HANDLER_TYPE_TX_TMR_TIMEOUT |
-		XVPHY_INTR_HANDLER_TYPE_RX_TMR_TIMEOUT);
+	XVphy_IntrEnable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
 
 	return IRQ_HANDLED;
 }
@@ -764,6 +940,148 @@ static int xvphy_phy_init(struct phy *phy)
 	BUG_ON(!phy);
 	return 0;
 }
+
+static u32 xvphy_pm_lock(struct xvphy_dev *vphydev, XVphy_DirectionType Dir);
+static void xvphy_pm_apply(struct xvphy_dev *vphydev);
+
+/* a direction is in use while powered on, and until its first power on */
+static bool xvphy_pm_dir_used(struct xvphy_dev *vphydev,
+			      XVphy_DirectionType Dir)
+{
+	return vphydev->pm_users[Dir] || !vphydev->pm_gating[Dir];
+}
+
+/* whether every configured direction is gated, xvphy_mutex held */
+static bool xvphy_pm_gating_all(struct xvphy_dev *vphydev)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+
+	if (InstancePtr->Config.RxChannels &&
+	    !vphydev->pm_gating[XVPHY_DIR_RX])
+		return false;
+	if (InstancePtr->Config.TxChannels &&
+	    !vphydev->pm_gating[XVPHY_DIR_TX])
+		return false;
+
+	return true;
+}
+
+/**
+ * xvphy_pm_get - take a power user reference on a direction
+ * @vphydev: pointer to the VPHY device
+ * @Dir: TX or RX
+ *
+ * Keeps the device runtime resumed. Once gating is enabled for @Dir, its
+ * first user ungates its PLL and lanes and runs a single reset and lock
+ * cycle on the retained configuration.
+ *
+ * Return: 0 on success, -ETIMEDOUT if the PLL did not lock or another
+ * negative error code
+ */
+static int xvphy_pm_get(struct xvphy_dev *vphydev, XVphy_DirectionType Dir)
+{
+	u32 Status = XST_SUCCESS;
+	int ret;
+
+	ret = pm_runtime_resume_and_get(vphydev->dev);
+	if (ret < 0)
+		return ret;
+
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	if (vphydev->pm_users[Dir]++ == 0 && vphydev->pm_gating[Dir]) {
+		XVphy_ResetGtPll(&vphydev->xvphy, 0, XVPHY_CHANNEL_ID_CHA, Dir,
+				 (TRUE));
+		xvphy_pm_apply(vphydev);
+		Status = xvphy_pm_lock(vphydev, Dir);
+		if (Status != XST_SUCCESS) {
+			vphydev->pm_users[Dir]--;
+			xvphy_pm_apply(vphydev);
+		}
+	}
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	if (Status != XST_SUCCESS) {
+		dev_err(vphydev->dev, "%s PLL did not lock on power on\n",
+			(Dir == XVPHY_DIR_TX) ? "TX" : "RX");
+		pm_runtime_mark_last_busy(vphydev->dev);
+		pm_runtime_put_autosuspend(vphydev->dev);
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/**
+ * xvphy_pm_put - drop a power user reference on a direction
+ * @vphydev: pointer to the VPHY device
+ * @Dir: TX or RX
+ */
+static void xvphy_pm_put(struct xvphy_dev *vphydev, XVphy_DirectionType Dir)
+{
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	if (vphydev->pm_users[Dir] && --vphydev->pm_users[Dir] == 0)
+		xvphy_pm_apply(vphydev);
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
+}
+
+/**
+ * xvphy_phy_power_on - power up the PLL and lanes of a lane's direction
+ * @phy: pointer to kernel PHY device
+ *
+ * The first power on of a direction hands its power management over to the
+ * PHY consumers: from then on the direction is gated while unused. RX and
+ * TX are handed over separately, as a controller may drive one direction
+ * through phy_power_on() and the other only through the DP callbacks. Once
+ * every configured direction is handed over the device may runtime suspend
+ * while no lane is powered on.
+ *
+ * Return: 0 on success or error on failure
+ */
+static int xvphy_phy_power_on(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	struct xvphy_dev *vphydev = vphy_lane->vphydev;
+	XVphy_DirectionType Dir = vphy_lane->direction ?
+				  XVPHY_DIR_TX : XVPHY_DIR_RX;
+	bool drop_hold = false;
+	int ret;
+
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	if (!vphydev->pm_gating[Dir]) {
+		vphydev->pm_gating[Dir] = true;
+		drop_hold = xvphy_pm_gating_all(vphydev);
+	}
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	ret = xvphy_pm_get(vphydev, Dir);
+
+	/* drop the reference probe holds for consumers without power_on */
+	if (drop_hold)
+		pm_runtime_put_noidle(vphydev->dev);
+
+	return ret;
+}
+
+/**
+ * xvphy_phy_power_off - power down a lane's direction once it is unused
+ * @phy: pointer to kernel PHY device
+ *
+ * Return: 0 on success or error on failure
+ */
+static int xvphy_phy_power_off(struct phy *phy)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+	XVphy_DirectionType Dir = vphy_lane->direction ?
+				  XVPHY_DIR_TX : XVPHY_DIR_RX;
+
+	xvphy_pm_put(vphy_lane->vphydev, Dir);
+
+	return 0;
+}
+
 static int xvphy_phy_reset(struct phy *phy)
 {
 	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
@@ -778,21 +1096,64 @@ static int xvphy_phy_configure(struct phy *phy, union phy_configure_opts *opts)
 {
 	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
 	struct xvphy_dev *vphydev = vphy_lane->vphydev;
+	XVphy_DirectionType Dir = vphy_lane->direction ?
+				  XVPHY_DIR_TX : XVPHY_DIR_RX;
+	int ret = 0;
 
 	BUG_ON(!phy);
+	if (opts->dp.set_rate &&
+	    !xvphy_dp_link_rate_valid(&vphydev->xvphy, opts->dp.link_rate,
+				      vphy_lane->direction))
+		return -EINVAL;
+	if (opts->dp.set_lanes &&
+	    !xvphy_dp_lanes_valid(&vphydev->xvphy, opts->dp.lanes,
+				  vphy_lane->direction))
+		return -EINVAL;
+	ret = pm_runtime_resume_and_get(vphydev->dev);
+	if (ret < 0)
+		return ret;
+	/* ahead of the rate, so its GT reset covers the lanes powered up */
+	if (opts->dp.set_lanes) {
+		hdmi_mutex_lock(&vphydev->xvphy_mutex);
+		vphydev->pm_lanes[Dir] = opts->dp.lanes;
+		xvphy_pm_apply(vphydev);
+		hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+		opts->dp.set_lanes = 0;
+	}
 	if(opts->dp.set_rate && !vphy_lane->direction) {
 		DpRxSs_LinkBandwidthHandler(opts->dp.link_rate);
 		opts->dp.set_rate = 0;
 	}
 	if(opts->dp.set_rate && vphy_lane->direction) {
 		dev_dbg(vphydev->dev,"%s:set_rate\n",__func__);
-		set_vphy(opts->dp.link_rate);
+		if (set_vphy(opts->dp.link_rate) != XST_SUCCESS)
+			ret = -EIO;
 		opts->dp.set_rate = 0;
 	}
-	if(opts->dp.set_voltages && vphy_lane->direction){
+	if(!ret && opts->dp.set_voltages && vphy_lane->direction){
 		xvphy_pe_vs_adjust_handler(&vphydev->xvphy, &opts->dp);
 		opts->dp.set_voltages = 0;
 	}
+	pm_runtime_mark_last_busy(vphydev->dev);
+	pm_runtime_put_autosuspend(vphydev->dev);
+
+	return ret;
+}
+static int xvphy_phy_validate(struct phy *phy, enum phy_mode mode,
+			      int submode, union phy_configure_opts *opts)
+{
+	struct xvphy_lane *vphy_lane = phy_get_drvdata(phy);
+
+	BUG_ON(!phy);
+	if (opts->dp.set_rate &&
+	    !xvphy_dp_link_rate_valid(&vphy_lane->vphydev->xvphy,
+				      opts->dp.link_rate,
+				      vphy_lane->direction))
+		return -EINVAL;
+	if (opts->dp.set_lanes &&
+	    !xvphy_dp_lanes_valid(&vphy_lane->vphydev->xvphy,
+				  opts->dp.lanes, vphy_lane->direction))
+		return -EINVAL;
 
 	return 0;
 }
@@ -853,9 +1214,12 @@ static struct phy *xvphy_xlate(struct device *dev,
 XVphy_Config XVphy_ConfigTable[XPAR_XVPHY_NUM_INSTANCES];
 
 static struct phy_ops xvphy_phyops = {
+	.validate	= xvphy_phy_validate,
 	.configure	= xvphy_phy_configure,
 	.reset		= xvphy_phy_reset,
 	.init		= xvphy_phy_init,
+	.power_on	= xvphy_phy_power_on,
+	.power_off	= xvphy_phy_power_off,
 	.owner		= THIS_MODULE,
 };
 
@@ -863,87 +1227,567 @@ static int instance = 0;
 /* TX uses [1, 127], RX uses [128, 254] and VPHY uses [256, ...]. Note that 255 is used for not-present. */
 #define VPHY_DEVICE_ID_BASE 256
 
-static int vphy_parse_of(struct xvphy_dev *vphydev, XVphy_Config *c)
+/* PLL divider selection policies, indexed by XVphy_PllPolicy */
+static const char * const xvphy_pll_policy_names[] = {
+	[XVPHY_PLL_POLICY_FIRST]	= "first",
+	[XVPHY_PLL_POLICY_LOW_VCO]	= "low-vco",
+	[XVPHY_PLL_POLICY_LOW_M]	= "low-m",
+	[XVPHY_PLL_POLICY_SAME_VCO]	= "same-vco",
+};
+
+static ssize_t pll_policy_show(struct device *dev,
+			       struct device_attribute *attr, char *buf)
 {
-	struct device *dev = vphydev->dev;
-	struct device_node *node = dev->of_node;
-	int rc;
-	u32 val;
-	bool has_err_irq;
+	return sprintf(buf, "%s\n",
+		       xvphy_pll_policy_names[XVphy_PllGetPolicy()]);
+}
 
-	rc = of_property_read_u32(node, "xlnx,transceiver-type", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->XcvrType = val;
-	rc = of_property_read_u32(node, "xlnx,input-pixels-per-clock", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->Ppc = val;
+static ssize_t pll_policy_store(struct device *dev,
+				struct device_attribute *attr,
+				const char *buf, size_t count)
+{
+	int policy;
 
-	rc = of_property_read_u32(node, "xlnx,nidru", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->DruIsPresent = val;
+	policy = sysfs_match_string(xvphy_pll_policy_names, buf);
+	if (policy < 0)
+		return policy;
 
-	rc = of_property_read_u32(node, "xlnx,nidru-refclk-sel", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->DruRefClkSel = val;
+	/* takes effect on the next line rate change */
+	XVphy_PllSetPolicy(policy);
 
-	rc = of_property_read_u32(node, "xlnx,rx-no-of-channels", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->RxChannels = val;
+	return count;
+}
+static DEVICE_ATTR_RW(pll_policy);
+
+/* PRBS bit error rate measurement */
+#define XVPHY_BER_SAMPLE_MS	250
+
+/* PRBS checker patterns, the first one stops the measurement */
+static const struct {
+	const char *name;
+	XVphy_PrbsPattern pattern;
+} xvphy_ber_patterns[] = {
+	{ "off",	XVPHY_PRBSSEL_STD_MODE },
+	{ "prbs7",	XVPHY_PRBSSEL_PRBS7 },
+	{ "prbs15",	XVPHY_PRBSSEL_PRBS15 },
+	{ "prbs23",	XVPHY_PRBSSEL_PRBS23 },
+	{ "prbs31",	XVPHY_PRBSSEL_PRBS31 },
+};
 
-	rc = of_property_read_u32(node, "xlnx,tx-no-of-channels", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->TxChannels = val;
+/*
+ * One-sided 95% Poisson confidence limits of the mean for a small observed
+ * error count, in thousandths. Larger counts use the approximations in
+ * xvphy_ber_bounds().
+ */
+static const u32 xvphy_ber_upper_milli[] = {
+	2996, 4744, 6296, 7754, 9154, 10513, 11842, 13148,
+	14435, 15705, 16962, 18208, 19443, 20669, 21886, 23097,
+};
 
-	rc = of_property_read_u32(node, "xlnx,rx-protocol", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->RxProtocol = val;
+static const u32 xvphy_ber_lower_milli[] = {
+	0, 51, 355, 818, 1366, 1970, 2613, 3285,
+	3981, 4695, 5425, 6169, 6924, 7690, 8464, 9246,
+};
 
-	rc = of_property_read_u32(node, "xlnx,tx-protocol", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->TxProtocol = val;
+static void xvphy_ber_bounds(u64 errors, u64 *lower, u64 *upper)
+{
+	u64 root;
 
-	rc = of_property_read_u32(node, "xlnx,rx-refclk-sel", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->RxRefClkSel = val;
+	if (errors < ARRAY_SIZE(xvphy_ber_upper_milli)) {
+		*lower = xvphy_ber_lower_milli[errors];
+		*upper = xvphy_ber_upper_milli[errors];
+		return;
+	}
 
-	rc = of_property_read_u32(node, "xlnx,tx-refclk-sel", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->TxRefClkSel = val;
+	/* E + 1.55 + 1.645 * sqrt(E + 1) and E + 0.6 - 1.645 * sqrt(E) */
+	root = int_sqrt64((errors + 1) * 1000000);
+	*upper = errors * 1000 + 1550 + div_u64(root * 1645, 1000);
+	root = int_sqrt64(errors * 1000000);
+	*lower = errors * 1000 + 600 - div_u64(root * 1645, 1000);
+}
 
-	rc = of_property_read_u32(node, "xlnx,rx-pll-selection", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->RxSysPllClkSel = val;
+/* print milli / 1000 / bits as a BER with three significant digits */
+static int xvphy_ber_print(char *buf, u64 milli, u64 bits)
+{
+	u64 pow10 = 1;
+	u64 m = 0;
+	int e;
+
+	if (!bits)
+		return sprintf(buf, " -");
+	if (!milli)
+		return sprintf(buf, " 0");
+	if (milli >= bits * 1000)
+		return sprintf(buf, " 1.00E+00");
+
+	for (e = 1; e < 20; e++) {
+		pow10 *= 10;
+		m = div_u64(mul_u64_u64_div_u64(milli, pow10, bits), 10);
+		if (m >= 100)
+			break;
+	}
 
-	rc = of_property_read_u32(node, "xlnx,tx-pll-selection", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->TxSysPllClkSel = val;
+	return sprintf(buf, " %llu.%02lluE-%02d", m / 100, m % 100, e);
+}
 
-	rc = of_property_read_u32(node, "xlnx,hdmi-fast-switch", &val);
-	if (rc < 0)
-		goto error_dt;
-	c->HdmiFastSwitch = val;
+/* lanes a PRBS test can run on, they need both a TX and an RX channel */
+static u8 xvphy_ber_lane_mask(XVphy *InstancePtr)
+{
+	u8 channels = min3(InstancePtr->Config.TxChannels,
+			   InstancePtr->Config.RxChannels,
+			   (u8)XVPHY_BER_MAX_LANES);
 
-	has_err_irq = false;
-	has_err_irq = of_property_read_bool(node, "xlnx,err-irq-en");
-	c->ErrIrq = has_err_irq;
+	return channels ? GENMASK(channels - 1, 0) : 0;
+}
 
-	c->xfmc_present =
-		of_property_read_bool(node, "xlnx,xfmc-present");
-	return 0;
+static u32 xvphy_ber_read_err_cnt(XVphy *InstancePtr, XVphy_ChannelId ch)
+{
+	u16 lower, upper, again;
+	int retry = 3;
+
+	/* the halves are read separately, retry if the count carried over */
+	XVphy_DrpRd(InstancePtr, 0, ch, XVPHY_DRP_GTHE4_PRBS_ERR_CNTR_UPPER,
+		    &upper);
+	do {
+		XVphy_DrpRd(InstancePtr, 0, ch,
+			    XVPHY_DRP_GTHE4_PRBS_ERR_CNTR_LOWER, &lower);
+		again = upper;
+		XVphy_DrpRd(InstancePtr, 0, ch,
+			    XVPHY_DRP_GTHE4_PRBS_ERR_CNTR_UPPER, &upper);
+	} while (upper != again && --retry);
+
+	return (u32)upper << 16 | lower;
+}
 
-error_dt:
+/* snapshot the counters of the lanes under test, takes xvphy_mutex */
+static ktime_t xvphy_ber_read(struct xvphy_ber *ber, u32 *err_cnt,
+			      u16 *sym_cnt, u64 *rate)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	u32 sym[2];
+	ktime_t now;
+	int i;
+
+	mutex_lock(&vphydev->xvphy_mutex);
+	now = ktime_get();
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++) {
+		if (!(ber->lanes & BIT(i)))
+			continue;
+		err_cnt[i] = xvphy_ber_read_err_cnt(InstancePtr,
+						    XVPHY_CHANNEL_ID_CH1 + i);
+		rate[i] = XVphy_GetLineRateHz(InstancePtr, 0,
+					      XVPHY_CHANNEL_ID_CH1 + i);
+	}
+	sym[0] = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+			       XVPHY_RX_SYM_ERR_CNTR_CH1_2_REG);
+	sym[1] = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+			       XVPHY_RX_SYM_ERR_CNTR_CH3_4_REG);
+	mutex_unlock(&vphydev->xvphy_mutex);
+
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++)
+		sym_cnt[i] = sym[i / 2] >> (16 * (i % 2));
+
+	return now;
+}
+
+/* fold the counter deltas since the last sample in, ber->lock held */
+static void xvphy_ber_sample(struct xvphy_ber *ber)
+{
+	u32 err_cnt[XVPHY_BER_MAX_LANES];
+	u16 sym_cnt[XVPHY_BER_MAX_LANES];
+	u64 rate[XVPHY_BER_MAX_LANES];
+	struct xvphy_ber_lane *lane;
+	ktime_t now;
+	u64 dt;
+	int i;
+
+	now = xvphy_ber_read(ber, err_cnt, sym_cnt, rate);
+	dt = ktime_to_ns(ktime_sub(now, ber->last));
+	ber->last = now;
+
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++) {
+		if (!(ber->lanes & BIT(i)))
+			continue;
+
+		lane = &ber->lane[i];
+		lane->bits += mul_u64_u64_div_u64(rate[i], dt, NSEC_PER_SEC);
+		/* the PRBS error counter saturates, the symbol one wraps */
+		lane->errors += err_cnt[i] - lane->last_err_cnt;
+		lane->sym_errors += (u16)(sym_cnt[i] - lane->last_sym_cnt);
+		lane->last_err_cnt = err_cnt[i];
+		lane->last_sym_cnt = sym_cnt[i];
+		if (err_cnt[i] == U32_MAX)
+			lane->saturated = true;
+	}
+}
+
+static void xvphy_ber_work(struct work_struct *work)
+{
+	struct xvphy_ber *ber = container_of(to_delayed_work(work),
+					     struct xvphy_ber, work);
+
+	mutex_lock(&ber->lock);
+	if (ber->running) {
+		xvphy_ber_sample(ber);
+		schedule_delayed_work(&ber->work,
+				      msecs_to_jiffies(XVPHY_BER_SAMPLE_MS));
+	}
+	mutex_unlock(&ber->lock);
+}
+
+/* program the PRBS generators and checkers of the lanes under test */
+static void xvphy_ber_set_pattern(struct xvphy_ber *ber,
+				  XVphy_PrbsPattern pattern)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	u32 reset = 0;
+	u32 regval;
+	int i;
+
+	mutex_lock(&vphydev->xvphy_mutex);
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++) {
+		if (!(ber->lanes & BIT(i)))
+			continue;
+		XVphy_SetPrbsSel(InstancePtr, 0, XVPHY_CHANNEL_ID_CH1 + i,
+				 XVPHY_DIR_TX, pattern);
+		XVphy_SetPrbsSel(InstancePtr, 0, XVPHY_CHANNEL_ID_CH1 + i,
+				 XVPHY_DIR_RX, pattern);
+		reset |= XVPHY_RX_CONTROL_RXPRBSCNTRESET_MASK(
+						XVPHY_CHANNEL_ID_CH1 + i);
+	}
+
+	if (pattern != XVPHY_PRBSSEL_STD_MODE) {
+		regval = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+				       XVPHY_RX_CONTROL_REG);
+		XVphy_WriteReg(InstancePtr->Config.BaseAddr,
+			       XVPHY_RX_CONTROL_REG, regval | reset);
+		XVphy_WriteReg(InstancePtr->Config.BaseAddr,
+			       XVPHY_RX_CONTROL_REG, regval & ~reset);
+	}
+	mutex_unlock(&vphydev->xvphy_mutex);
+}
+
+/* ber->lock held */
+static void xvphy_ber_stop(struct xvphy_ber *ber)
+{
+	if (!ber->running)
+		return;
+
+	/* a sample already waiting on ber->lock sees !running and bails */
+	ber->running = false;
+	cancel_delayed_work(&ber->work);
+
+	xvphy_ber_sample(ber);
+	xvphy_ber_set_pattern(ber, XVPHY_PRBSSEL_STD_MODE);
+
+	xvphy_pm_put(vphydev, XVPHY_DIR_RX);
+	xvphy_pm_put(vphydev, XVPHY_DIR_TX);
+}
+
+/* ber->lock held */
+static int xvphy_ber_start(struct xvphy_ber *ber, XVphy_PrbsPattern pattern)
+{
+	u32 err_cnt[XVPHY_BER_MAX_LANES];
+	u16 sym_cnt[XVPHY_BER_MAX_LANES];
+	u64 rate[XVPHY_BER_MAX_LANES];
+	int ret;
+	int i;
+
+	/* the generators and checkers need both directions powered on */
+	ret = xvphy_pm_get(vphydev, XVPHY_DIR_TX);
+	if (ret)
+		return ret;
+	ret = xvphy_pm_get(vphydev, XVPHY_DIR_RX);
+	if (ret) {
+		xvphy_pm_put(vphydev, XVPHY_DIR_TX);
+		return ret;
+	}
+
+	xvphy_ber_set_pattern(ber, pattern);
+
+	memset(ber->lane, 0, sizeof(ber->lane));
+	ber->start = xvphy_ber_read(ber, err_cnt, sym_cnt, rate);
+	ber->last = ber->start;
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++) {
+		if (!(ber->lanes & BIT(i)))
+			continue;
+		ber->lane[i].last_err_cnt = err_cnt[i];
+		ber->lane[i].last_sym_cnt = sym_cnt[i];
+	}
+
+	ber->pattern = pattern;
+	ber->running = true;
+	schedule_delayed_work(&ber->work,
+			      msecs_to_jiffies(XVPHY_BER_SAMPLE_MS));
+
+	return 0;
+}
+
+static void xvphy_ber_release(void *data)
+{
+	struct xvphy_ber *ber = data;
+
+	mutex_lock(&ber->lock);
+	xvphy_ber_stop(ber);
+	mutex_unlock(&ber->lock);
+	cancel_delayed_work_sync(&ber->work);
+}
+
+static ssize_t prbs_pattern_show(struct device *dev,
+				 struct device_attribute *attr, char *buf)
+{
+	struct xvphy_ber *ber = &vphydev->ber;
+	const char *name = xvphy_ber_patterns[0].name;
+	int i;
+
+	mutex_lock(&ber->lock);
+	for (i = 1; ber->running && i < ARRAY_SIZE(xvphy_ber_patterns); i++)
+		if (xvphy_ber_patterns[i].pattern == ber->pattern)
+			name = xvphy_ber_patterns[i].name;
+	mutex_unlock(&ber->lock);
+
+	return sprintf(buf, "%s\n", name);
+}
+
+static ssize_t prbs_pattern_store(struct device *dev,
+				  struct device_attribute *attr,
+				  const char *buf, size_t count)
+{
+	struct xvphy_ber *ber = &vphydev->ber;
+	int ret = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_ber_patterns); i++)
+		if (sysfs_streq(buf, xvphy_ber_patterns[i].name))
+			break;
+	if (i == ARRAY_SIZE(xvphy_ber_patterns))
+		return -EINVAL;
+
+	/* any pattern restarts the measurement from zero */
+	mutex_lock(&ber->lock);
+	xvphy_ber_stop(ber);
+	if (i)
+		ret = xvphy_ber_start(ber, xvphy_ber_patterns[i].pattern);
+	mutex_unlock(&ber->lock);
+
+	return ret ? ret : count;
+}
+static DEVICE_ATTR_RW(prbs_pattern);
+
+static ssize_t prbs_lanes_show(struct device *dev,
+			       struct device_attribute *attr, char *buf)
+{
+	return sprintf(buf, "0x%x\n", vphydev->ber.lanes);
+}
+
+static ssize_t prbs_lanes_store(struct device *dev,
+				struct device_attribute *attr,
+				const char *buf, size_t count)
+{
+	struct xvphy_ber *ber = &vphydev->ber;
+	u8 lanes;
+	int ret;
+
+	ret = kstrtou8(buf, 0, &lanes);
+	if (ret)
+		return ret;
+	if (!lanes || lanes & ~xvphy_ber_lane_mask(&vphydev->xvphy))
+		return -EINVAL;
+
+	mutex_lock(&ber->lock);
+	if (ber->running)
+		ret = -EBUSY;
+	else
+		ber->lanes = lanes;
+	mutex_unlock(&ber->lock);
+
+	return ret ? ret : count;
+}
+static DEVICE_ATTR_RW(prbs_lanes);
+
+static ssize_t prbs_inject_store(struct device *dev,
+				 struct device_attribute *attr,
+				 const char *buf, size_t count)
+{
+	struct xvphy_ber *ber = &vphydev->ber;
+	XVphy *InstancePtr = &vphydev->xvphy;
+	u8 lane;
+	int ret;
+
+	ret = kstrtou8(buf, 0, &lane);
+	if (ret)
+		return ret;
+	if (lane >= XVPHY_BER_MAX_LANES)
+		return -EINVAL;
+
+	mutex_lock(&ber->lock);
+	if (!ber->running || !(ber->lanes & BIT(lane))) {
+		ret = -EINVAL;
+	} else {
+		/* errors are forced for as long as the bit is set */
+		mutex_lock(&vphydev->xvphy_mutex);
+		XVphy_TxPrbsForceError(InstancePtr, 0,
+				       XVPHY_CHANNEL_ID_CH1 + lane, 1);
+		XVphy_TxPrbsForceError(InstancePtr, 0,
+				       XVPHY_CHANNEL_ID_CH1 + lane, 0);
+		mutex_unlock(&vphydev->xvphy_mutex);
+	}
+	mutex_unlock(&ber->lock);
+
+	return ret ? ret : count;
+}
+static DEVICE_ATTR_WO(prbs_inject);
+
+/*
+ * Per lane report of the current or last measurement. ber_low and ber_high
+ * are one-sided 95% confidence bounds, an errors count ending in '+' means
+ * the GT counter saturated and the count is a lower limit.
+ */
+static ssize_t prbs_ber_show(struct device *dev,
+			     struct device_attribute *attr, char *buf)
+{
+	struct xvphy_ber *ber = &vphydev->ber;
+	struct xvphy_ber_lane *lane;
+	u64 lower, upper;
+	ssize_t len;
+	int i;
+
+	mutex_lock(&ber->lock);
+	if (ber->running)
+		xvphy_ber_sample(ber);
+
+	len = sprintf(buf, "time_ms %lld\n",
+		      ktime_ms_delta(ber->last, ber->start));
+	len += sprintf(buf + len,
+		       "lane bits errors symbol_errors ber ber_low ber_high\n");
+	for (i = 0; i < XVPHY_BER_MAX_LANES; i++) {
+		if (!(ber->lanes & BIT(i)))
+			continue;
+
+		lane = &ber->lane[i];
+		xvphy_ber_bounds(lane->errors, &lower, &upper);
+		len += sprintf(buf + len, "%d %llu %llu%s %llu", i, lane->bits,
+			       lane->errors, lane->saturated ? "+" : "",
+			       lane->sym_errors);
+		len += xvphy_ber_print(buf + len, lane->errors * 1000,
+				       lane->bits);
+		len += xvphy_ber_print(buf + len, lower, lane->bits);
+		len += xvphy_ber_print(buf + len, upper, lane->bits);
+		len += sprintf(buf + len, "\n");
+	}
+	mutex_unlock(&ber->lock);
+
+	return len;
+}
+static DEVICE_ATTR_RO(prbs_ber);
+
+static struct attribute *xvphy_attrs[] = {
+	&dev_attr_pll_policy.attr,
+	&dev_attr_prbs_pattern.attr,
+	&dev_attr_prbs_lanes.attr,
+	&dev_attr_prbs_inject.attr,
+	&dev_attr_prbs_ber.attr,
+	NULL,
+};
+
+static const struct attribute_group xvphy_attr_group = {
+	.attrs = xvphy_attrs,
+};
+
+static int vphy_parse_of(struct xvphy_dev *vphydev, XVphy_Config *c)
+{
+	struct device *dev = vphydev->dev;
+	struct device_node *node = dev->of_node;
+	const char *policy;
+	int rc;
+	u32 val;
+	bool has_err_irq;
+
+	rc = of_property_read_u32(node, "xlnx,transceiver-type", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->XcvrType = val;
+	if (!XVphy_GtAdaptorLookup(c->XcvrType)) {
+		dev_err(dev, "unsupported transceiver type %u\n", val);
+		return -ENODEV;
+	}
+	rc = of_property_read_u32(node, "xlnx,input-pixels-per-clock", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->Ppc = val;
+
+	rc = of_property_read_u32(node, "xlnx,nidru", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->DruIsPresent = val;
+
+	rc = of_property_read_u32(node, "xlnx,nidru-refclk-sel", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->DruRefClkSel = val;
+
+	rc = of_property_read_u32(node, "xlnx,rx-no-of-channels", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->RxChannels = val;
+
+	rc = of_property_read_u32(node, "xlnx,tx-no-of-channels", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->TxChannels = val;
+
+	rc = of_property_read_u32(node, "xlnx,rx-protocol", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->RxProtocol = val;
+
+	rc = of_property_read_u32(node, "xlnx,tx-protocol", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->TxProtocol = val;
+
+	rc = of_property_read_u32(node, "xlnx,rx-refclk-sel", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->RxRefClkSel = val;
+
+	rc = of_property_read_u32(node, "xlnx,tx-refclk-sel", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->TxRefClkSel = val;
+
+	rc = of_property_read_u32(node, "xlnx,rx-pll-selection", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->RxSysPllClkSel = val;
+
+	rc = of_property_read_u32(node, "xlnx,tx-pll-selection", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->TxSysPllClkSel = val;
+
+	rc = of_property_read_u32(node, "xlnx,hdmi-fast-switch", &val);
+	if (rc < 0)
+		goto error_dt;
+	c->HdmiFastSwitch = val;
+
+	has_err_irq = false;
+	has_err_irq = of_property_read_bool(node, "xlnx,err-irq-en");
+	c->ErrIrq = has_err_irq;
+
+	c->xfmc_present =
+		of_property_read_bool(node, "xlnx,xfmc-present");
+
+	if (!of_property_read_string(node, "xlnx,pll-policy", &policy)) {
+		rc = match_string(xvphy_pll_policy_names,
+				  ARRAY_SIZE(xvphy_pll_policy_names), policy);
+		if (rc < 0)
+			goto error_dt;
+		XVphy_PllSetPolicy(rc);
+	}
+	return 0;
+
+error_dt:
 	dev_err(vphydev->dev, "Error parsing device tree");
 	return -EINVAL;
 }
@@ -1061,6 +1905,53 @@ static const struct regmap_config fmc_regmap_config = {
 };
 
 //struct xvphy_dev *vphydev_g;
+
+/**
+ * xvphy_link_vfmc - make the Video FMC a supplier of the VPHY
+ * @dev: VPHY device
+ *
+ * The FMC brings up the GT reference clock, retimer and redriver. A managed
+ * device link lets the driver core hold off the VPHY probe until the FMC
+ * driver is bound, and probe it right after, instead of the VPHY probe being
+ * retried on every deferred probe pass.
+ *
+ * Return: 0 when the FMC is ready or not described, -EPROBE_DEFER once while
+ * it is being brought up, other error codes on failure
+ */
+static int xvphy_link_vfmc(struct device *dev)
+{
+	struct platform_device *iface_pdev;
+	struct device_node *fnode;
+	struct device_link *link;
+	int ret = 0;
+
+	fnode = of_parse_phandle(dev->of_node, "xlnx,xilinx-vfmc", 0);
+	if (!fnode) {
+		dev_err(dev, "xilinx-vfmc not found in DT\n");
+		return 0;
+	}
+
+	iface_pdev = of_find_device_by_node(fnode);
+	of_node_put(fnode);
+	if (!iface_pdev)
+		return -ENODEV;
+
+	link = device_link_add(dev, &iface_pdev->dev,
+			       DL_FLAG_AUTOPROBE_CONSUMER);
+	if (!link)
+		dev_warn(dev, "no device link to xilinx-vfmc\n");
+
+	/* the FMC sets its driver data once the bring-up is done */
+	if (!dev_get_drvdata(&iface_pdev->dev)) {
+		dev_info(dev, "xilinx-vfmc not ready -EPROBE_DEFER\n");
+		ret = -EPROBE_DEFER;
+	}
+
+	put_device(&iface_pdev->dev);
+
+	return ret;
+}
+
 /**
  * xvphy_probe - The device probe function for driver initialization.
  * @pdev: pointer to the platform device structure.
@@ -1071,8 +1962,6 @@ static int xvphy_probe(struct platform_device *pdev)
 {
 	struct device_node *child, *np = pdev->dev.of_node;
 	struct phy_provider *provider;
-	struct device_node *fnode;
-	struct platform_device *iface_pdev;
 	struct xvphy_cfg *xvphy_prvdata;
 	struct phy *phy;
 	unsigned long axi_lite_rate;
@@ -1080,46 +1969,32 @@ static int xvphy_probe(struct platform_device *pdev)
 	unsigned int Status=1;
 	struct resource *res;
 	int port = 0, index = 0;
-	void *ptr;
 	int ret;
 
 	dev_info(&pdev->dev, "xlnx-dp-vphy: probed\n");
+
+	BUG_ON(!np);
+
+	ret = xvphy_link_vfmc(&pdev->dev);
+	if (ret)
+		return ret;
+
 	vphydev = devm_kzalloc(&pdev->dev, sizeof(*vphydev), GFP_KERNEL);
 	if (!vphydev)
 		return -ENOMEM;
 
 	/* mutex that protects against concurrent access */
 	mutex_init(&vphydev->xvphy_mutex);
+	mutex_init(&vphydev->ber.lock);
+	INIT_DELAYED_WORK(&vphydev->ber.work, xvphy_ber_work);
 
 	vphydev->dev = &pdev->dev;
 	xvphy_prvdata = &xvphy_cfg_data;
 	/* set a pointer to our driver data */
 	platform_set_drvdata(pdev, xvphy_prvdata);
 
-	BUG_ON(!np);
-
 	XVphy_ConfigTable[instance].DeviceId = VPHY_DEVICE_ID_BASE + instance;
 
-	fnode = of_parse_phandle(np, "xlnx,xilinx-vfmc", 0);
-	if (!fnode) {
-		dev_err(&pdev->dev, "xilinx-vfmc not found in DT\n");
-		of_node_put(fnode);
-	} else {
-		iface_pdev = of_find_device_by_node(fnode);
-		if (!iface_pdev) {
-			of_node_put(np);
-			return -ENODEV;
-		}
-		ptr = dev_get_drvdata(&iface_pdev->dev);
-		if (!ptr) {
-			dev_info(&pdev->dev,
-				 "xilinx-vfmc device not found -EPROBE_DEFER\n");
-			of_node_put(fnode);
-			return -EPROBE_DEFER;
-		}
-		of_node_put(fnode);
-	}
-
 	dev_dbg(vphydev->dev,"DT parse start\n");
 	ret = vphy_parse_of(vphydev, &XVphy_ConfigTable[instance]);
 	if (ret) return ret;
@@ -1179,14 +2054,37 @@ static int xvphy_probe(struct platform_device *pdev)
 	drp_clk_rate = clk_get_rate(vphydev->drp_clk);
 	
 	XVphy_ConfigTable[instance].DrpClkFreq = drp_clk_rate;
+
+	/* GT reference clock, from the IDT synthesizer on the FMC */
+	vphydev->refclk = devm_clk_get_optional_enabled(&pdev->dev, "refclk");
+	if (IS_ERR(vphydev->refclk))
+		return dev_err_probe(&pdev->dev, PTR_ERR(vphydev->refclk),
+				     "failed to get the refclk\n");
+	if (vphydev->refclk) {
+		/*
+		 * The PLL setup runs from a 270 MHz reference, have the
+		 * synthesizer's dividers programmed for it if it is elsewhere
+		 */
+		ret = clk_set_rate(vphydev->refclk,
+				   XVPHY_DP_REF_CLK_FREQ_HZ_270);
+		if (ret)
+			return dev_err_probe(&pdev->dev, ret,
+					     "failed to set the refclk rate\n");
+		dev_dbg(&pdev->dev, "refclk %lu Hz\n",
+			clk_get_rate(vphydev->refclk));
+	}
 	
-	PLLRefClkSel (&vphydev->xvphy, PHY_User_Config_Table[9].LineRate);
 	XVphy_DpInitialize(&vphydev->xvphy,&XVphy_ConfigTable[instance], 0,
 			   PHY_User_Config_Table[9].CPLLRefClkSrc,
 			   PHY_User_Config_Table[9].QPLLRefClkSrc,
 			   PHY_User_Config_Table[9].TxPLL,
 			   PHY_User_Config_Table[9].RxPLL,
 			   PHY_User_Config_Table[9].LineRate);
+	/*
+	 * DpInitialize() resets the instance and binds the GT adaptor, so the
+	 * reference clock is selected after it, indexing its PLL solutions
+	 */
+	PLLRefClkSel (&vphydev->xvphy, PHY_User_Config_Table[9].LineRate);
 
 	//setting vswing
 	xvphy_SetTxVoltageSwing(&vphydev->xvphy, XVPHY_CHANNEL_ID_CH1,
@@ -1216,6 +2114,19 @@ static int xvphy_probe(struct platform_device *pdev)
 
 	Status = PHY_Configuration_Tx(&vphydev->xvphy,
 				PHY_User_Config_Table[(is_TX_CPLL) ? 2 : 5]);
+
+	/*
+	 * The GT is left configured and powered. Runtime PM must be enabled
+	 * before the lanes are created so the PHY core propagates the lane
+	 * power references; after the first lane power on, once no lane is
+	 * powered on the PLLs, MMCMs and lanes are gated after the
+	 * autosuspend delay.
+	 */
+	pm_runtime_set_active(&pdev->dev);
+	pm_runtime_set_autosuspend_delay(&pdev->dev, XVPHY_AUTOSUSPEND_DELAY_MS);
+	pm_runtime_use_autosuspend(&pdev->dev);
+	pm_runtime_enable(&pdev->dev);
+
 	for_each_child_of_node(np, child) {
 		struct xvphy_lane *vphy_lane;
 
@@ -1241,6 +2152,7 @@ static int xvphy_probe(struct platform_device *pdev)
 				dev_info(&pdev->dev, "xvphy probe deferred\n");
 			if (ret != -EPROBE_DEFER)
 				dev_err(&pdev->dev, "failed to create PHY\n");
+			pm_runtime_disable(&pdev->dev);
 			return ret;
 		}
 		/* array of pointer to phy */
@@ -1256,6 +2168,7 @@ static int xvphy_probe(struct platform_device *pdev)
 	provider = devm_of_phy_provider_register(&pdev->dev, xvphy_xlate);
 	if (IS_ERR(provider)) {
 		dev_err(&pdev->dev, "registering provider failed\n");
+		pm_runtime_disable(&pdev->dev);
 		return PTR_ERR(provider);
 	}
 
@@ -1265,6 +2178,23 @@ static int xvphy_probe(struct platform_device *pdev)
 					"xilinx-vphy", vphydev/*dev_id*/);
 	if (ret) {
 		dev_err(&pdev->dev, "unable to request IRQ %d\n", vphydev->irq);
+		pm_runtime_disable(&pdev->dev);
+		return ret;
+	}
+
+	/* test every lane the configuration has by default */
+	vphydev->ber.lanes = xvphy_ber_lane_mask(&vphydev->xvphy);
+	ret = devm_add_action_or_reset(&pdev->dev, xvphy_ber_release,
+				       &vphydev->ber);
+	if (ret) {
+		pm_runtime_disable(&pdev->dev);
+		return ret;
+	}
+
+	ret = devm_device_add_group(&pdev->dev, &xvphy_attr_group);
+	if (ret) {
+		dev_err(&pdev->dev, "failed to create sysfs attributes\n");
+		pm_runtime_disable(&pdev->dev);
 		return ret;
 	}
 
@@ -1277,12 +2207,496 @@ static int xvphy_probe(struct platform_device *pdev)
 
 	/* probe has succeeded for this instance, increment instance index */
 	instance++;
+	/*
+	 * Stay resumed until consumers power lanes on, the reference is
+	 * dropped once xvphy_phy_power_on() has gated every direction.
+	 */
+	pm_runtime_get_noresume(&pdev->dev);
 	/* Complete PHY dump */
 
 
 	return 0;
 }
 
+/*
+ * AXI-lite control registers restored on resume, in programming order.
+ * PLL/GT reset bits in TX_INIT/RX_INIT are owned by the reset sequence,
+ * only the USERRDY bits are carried across suspend.
+ */
+static const u16 xvphy_pm_axi_regs[] = {
+	XVPHY_REF_CLK_SEL_REG,
+	XVPHY_IBUFDS_GTXX_CTRL_REG,
+	XVPHY_POWERDOWN_CONTROL_REG,
+	XVPHY_LOOPBACK_CONTROL_REG,
+	XVPHY_CPLL_CAL_PERIOD_REG,
+	XVPHY_CPLL_CAL_TOL_REG,
+	XVPHY_TX_CONTROL_REG,
+	XVPHY_TX_BUFFER_BYPASS_REG,
+	XVPHY_TX_DRIVER_CH12_REG,
+	XVPHY_TX_DRIVER_CH34_REG,
+	XVPHY_RX_CONTROL_REG,
+	XVPHY_RX_EQ_CDR_REG,
+	XVPHY_MMCM_TXUSRCLK_REG1,
+	XVPHY_MMCM_TXUSRCLK_REG2,
+	XVPHY_MMCM_TXUSRCLK_REG3,
+	XVPHY_MMCM_TXUSRCLK_REG4,
+	XVPHY_BUFGGT_TXUSRCLK_REG,
+	XVPHY_MISC_TXUSRCLK_REG,
+	XVPHY_MMCM_RXUSRCLK_REG1,
+	XVPHY_MMCM_RXUSRCLK_REG2,
+	XVPHY_MMCM_RXUSRCLK_REG3,
+	XVPHY_MMCM_RXUSRCLK_REG4,
+	XVPHY_BUFGGT_RXUSRCLK_REG,
+	XVPHY_MISC_RXUSRCLK_REG,
+	XVPHY_CLKDET_CTRL_REG,
+	XVPHY_CLKDET_FREQ_TMR_TO_REG,
+	XVPHY_TX_INIT_REG,
+	XVPHY_RX_INIT_REG,
+};
+
+/* GTHE4 COMMON DRP words programmed by the QPLL0/QPLL1 reconfiguration */
+static const u16 xvphy_pm_cmn_drp[] = {
+	0x0D, 0x14, 0x16, 0x18, 0x19, 0x24, 0x25, 0x30,
+	0x8D, 0x94, 0x96, 0x98, 0x99, 0xA4, 0xA5, 0xB0,
+};
+
+/* GTHE4 CHANNEL DRP words programmed by the CPLL, divider, CDR and
+ * data width reconfiguration */
+static const u16 xvphy_pm_ch_drp[] = {
+	XVPHY_DRP_CPLL_FBDIV, XVPHY_DRP_CPLL_REFCLK_DIV, 0xBC, 0xCB, 0xCC,
+	XVPHY_DRP_RX_DATA_WIDTH, XVPHY_DRP_RX_INT_DATA_WIDTH,
+	TX_DATA_WIDTH_REG, TX_INT_DATAWIDTH_REG,
+	XVPHY_DRP_RXOUT_DIV, XVPHY_DRP_TXOUT_DIV,
+	XVPHY_DRP_RXCLK25,
+	0x0E, 0x0F, 0x10, 0x11, 0x12, 0xA4, 0x11B,
+	0x9C, 0x9D, 0xFB, 0xFF, 0x100, 0x116,
+};
+
+static u32 xvphy_pm_init_mask(u16 reg)
+{
+	if (reg == XVPHY_TX_INIT_REG)
+		return XVPHY_TX_INIT_USERRDY_ALL_MASK;
+	if (reg == XVPHY_RX_INIT_REG)
+		return XVPHY_RX_INIT_USERRDY_ALL_MASK;
+	return 0xFFFFFFFF;
+}
+
+/* last channel the core is configured with, the DRP image stops there */
+static XVphy_ChannelId xvphy_pm_last_ch(XVphy *InstancePtr)
+{
+	u8 channels = max(InstancePtr->Config.TxChannels,
+			  InstancePtr->Config.RxChannels);
+
+	return XVPHY_CHANNEL_ID_CH1 + clamp_t(u8, channels, 1, 4) - 1;
+}
+
+/**
+ * xvphy_pm_save - capture the AXI-lite and DRP register image
+ * @vphydev: pointer to the VPHY device
+ *
+ * Must be called with xvphy_mutex held and the DRP clock running.
+ *
+ * Return: 0 on success or -EIO when a DRP word could not be read
+ */
+static int xvphy_pm_save(struct xvphy_dev *vphydev)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	u32 Status = XST_SUCCESS;
+	int ch, i, n = 0;
+
+	BUILD_BUG_ON(ARRAY_SIZE(xvphy_pm_axi_regs) > XVPHY_PM_MAX_AXI_REGS);
+	BUILD_BUG_ON(ARRAY_SIZE(xvphy_pm_cmn_drp) +
+		     4 * ARRAY_SIZE(xvphy_pm_ch_drp) > XVPHY_PM_MAX_DRP_WORDS);
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_pm_axi_regs); i++)
+		vphydev->pm_axi[i] = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+						   xvphy_pm_axi_regs[i]) &
+				     xvphy_pm_init_mask(xvphy_pm_axi_regs[i]);
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_pm_cmn_drp); i++)
+		Status |= XVphy_DrpRd(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN,
+				      xvphy_pm_cmn_drp[i], &vphydev->pm_drp[n++]);
+
+	for (ch = XVPHY_CHANNEL_ID_CH1; ch <= xvphy_pm_last_ch(InstancePtr);
+	     ch++)
+		for (i = 0; i < ARRAY_SIZE(xvphy_pm_ch_drp); i++)
+			Status |= XVphy_DrpRd(InstancePtr, 0, ch,
+					      xvphy_pm_ch_drp[i],
+					      &vphydev->pm_drp[n++]);
+
+	return (Status == XST_SUCCESS) ? 0 : -EIO;
+}
+
+/**
+ * xvphy_pm_pll_mask - POWERDOWN_CONTROL bits of a PLL over all channels
+ * @PllType: the PLL type
+ *
+ * Return: power down mask, 0 for an unknown PLL type
+ */
+static u32 xvphy_pm_pll_mask(XVphy_PllType PllType)
+{
+	u32 MaskVal = 0;
+	u8 Id;
+
+	for (Id = XVPHY_CHANNEL_ID_CH1; Id <= XVPHY_CHANNEL_ID_CH4; Id++) {
+		switch (PllType) {
+		case XVPHY_PLL_TYPE_CPLL:
+			MaskVal |= XVPHY_POWERDOWN_CONTROL_CPLLPD_MASK(Id);
+			break;
+		case XVPHY_PLL_TYPE_QPLL:
+		case XVPHY_PLL_TYPE_QPLL0:
+			MaskVal |= XVPHY_POWERDOWN_CONTROL_QPLL0PD_MASK(Id);
+			break;
+		case XVPHY_PLL_TYPE_QPLL1:
+			MaskVal |= XVPHY_POWERDOWN_CONTROL_QPLL1PD_MASK(Id);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return MaskVal;
+}
+
+/**
+ * xvphy_pm_lane_mask - POWERDOWN_CONTROL TXPD/RXPD bits of the lanes
+ * @Dir: TX or RX
+ * @Lanes: number of lanes from CH1, 0 for all channels
+ *
+ * Setting both bits of the field selects the P2 power down state.
+ *
+ * Return: power down mask
+ */
+static u32 xvphy_pm_lane_mask(XVphy_DirectionType Dir, u8 Lanes)
+{
+	u8 LastId = Lanes ? XVPHY_CHANNEL_ID_CH1 + Lanes - 1 :
+			    XVPHY_CHANNEL_ID_CH4;
+	u32 MaskVal = 0;
+	u8 Id;
+
+	for (Id = XVPHY_CHANNEL_ID_CH1; Id <= LastId; Id++)
+		MaskVal |= (Dir == XVPHY_DIR_TX) ?
+			   XVPHY_POWERDOWN_CONTROL_TXPD_MASK(Id) :
+			   XVPHY_POWERDOWN_CONTROL_RXPD_MASK(Id);
+
+	return MaskVal;
+}
+
+/**
+ * xvphy_pm_apply - power down the PLLs, MMCMs and lanes nobody uses
+ * @vphydev: pointer to the VPHY device
+ *
+ * A direction is in use while at least one of its lanes is powered on by a
+ * consumer. The PLL feeding an active direction, and the lanes of the lane
+ * count set through phy_configure(), are kept powered; everything else is
+ * held in power down. The DRP configuration of
+ * a powered down PLL is retained, so powering it up again only needs a lock
+ * cycle. A direction is not gated before its first phy_power_on().
+ *
+ * Must be called with xvphy_mutex held.
+ */
+static void xvphy_pm_apply(struct xvphy_dev *vphydev)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	XVphy_DirectionType Dir;
+	XVphy_ProtocolType Protocol;
+	u32 PdMask, Used = 0;
+	u32 RegOffsetCtrl;
+	u32 RegVal;
+
+	/* consumers that never power lanes on program the GT directly */
+	if (!vphydev->pm_gating[XVPHY_DIR_RX] &&
+	    !vphydev->pm_gating[XVPHY_DIR_TX])
+		return;
+
+	PdMask = xvphy_pm_pll_mask(XVPHY_PLL_TYPE_CPLL) |
+		 xvphy_pm_pll_mask(XVPHY_PLL_TYPE_QPLL0) |
+		 xvphy_pm_pll_mask(XVPHY_PLL_TYPE_QPLL1) |
+		 xvphy_pm_lane_mask(XVPHY_DIR_TX, 0) |
+		 xvphy_pm_lane_mask(XVPHY_DIR_RX, 0);
+
+	for (Dir = XVPHY_DIR_RX; Dir <= XVPHY_DIR_TX; Dir++) {
+		if (!xvphy_pm_dir_used(vphydev, Dir))
+			continue;
+		Used |= xvphy_pm_pll_mask(XVphy_GetPllType(InstancePtr, 0, Dir,
+						XVPHY_CHANNEL_ID_CH1));
+		Used |= xvphy_pm_lane_mask(Dir, vphydev->pm_lanes[Dir]);
+	}
+
+	RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+			       XVPHY_POWERDOWN_CONTROL_REG);
+	RegVal &= ~PdMask;
+	RegVal |= PdMask & ~Used;
+	XVphy_WriteReg(InstancePtr->Config.BaseAddr,
+		       XVPHY_POWERDOWN_CONTROL_REG, RegVal);
+
+	/* The user clock MMCMs only drive HDMI, DP runs from BUFG_GT. */
+	for (Dir = XVPHY_DIR_RX; Dir <= XVPHY_DIR_TX; Dir++) {
+		Protocol = (Dir == XVPHY_DIR_TX) ?
+			   InstancePtr->Config.TxProtocol :
+			   InstancePtr->Config.RxProtocol;
+		if (!xvphy_pm_dir_used(vphydev, Dir) ||
+		    Protocol != XVPHY_PROTOCOL_HDMI) {
+			XVphy_MmcmPowerDown(InstancePtr, 0, Dir, (TRUE));
+			continue;
+		}
+
+		RegOffsetCtrl = (Dir == XVPHY_DIR_TX) ?
+				XVPHY_MMCM_TXUSRCLK_CTRL_REG :
+				XVPHY_MMCM_RXUSRCLK_CTRL_REG;
+		RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+				       RegOffsetCtrl);
+		RegVal &= ~XVPHY_MMCM_USRCLK_CTRL_PWRDWN_MASK;
+		XVphy_WriteReg(InstancePtr->Config.BaseAddr, RegOffsetCtrl,
+			       RegVal);
+	}
+}
+
+/**
+ * xvphy_pm_lock - release the GT reset of a direction and wait for lock
+ * @vphydev: pointer to the VPHY device
+ * @Dir: TX or RX
+ *
+ * Must be called with xvphy_mutex held.
+ *
+ * Return: XST_SUCCESS or XST_FAILURE
+ */
+static u32 xvphy_pm_lock(struct xvphy_dev *vphydev, XVphy_DirectionType Dir)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	XVphy_ChannelId PllChId;
+	u32 Status;
+
+	switch (XVphy_GetPllType(InstancePtr, 0, Dir, XVPHY_CHANNEL_ID_CH1)) {
+	case XVPHY_PLL_TYPE_QPLL:
+	case XVPHY_PLL_TYPE_QPLL0:
+		PllChId = XVPHY_CHANNEL_ID_CMN0;
+		break;
+	case XVPHY_PLL_TYPE_QPLL1:
+		PllChId = XVPHY_CHANNEL_ID_CMN1;
+		break;
+	default:
+		PllChId = XVPHY_CHANNEL_ID_CHA;
+		break;
+	}
+
+	XVphy_BufgGtReset(InstancePtr, Dir, (TRUE));
+	XVphy_ResetGtPll(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA, Dir, (FALSE));
+	XVphy_BufgGtReset(InstancePtr, Dir, (FALSE));
+
+	Status = XVphy_WaitForPllLock(InstancePtr, 0, PllChId);
+	Status |= XVphy_WaitForResetDone(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
+					 Dir);
+
+	return Status;
+}
+
+/**
+ * xvphy_pm_restore - replay the saved register image
+ * @vphydev: pointer to the VPHY device
+ * @Lock: release the GT reset of the active directions and wait for lock
+ *
+ * The control registers are written back first so the reference clock
+ * selection is valid, then the GT is held in reset while the DRP image is
+ * replayed, and released once for a single PLL lock cycle. Without @Lock
+ * the GT stays in reset until a consumer powers its lanes on.
+ *
+ * Must be called with xvphy_mutex held.
+ *
+ * Return: XST_SUCCESS or XST_FAILURE
+ */
+static u32 xvphy_pm_restore(struct xvphy_dev *vphydev, u8 Lock)
+{
+	XVphy *InstancePtr = &vphydev->xvphy;
+	XVphy_DirectionType Dir;
+	u32 Status = XST_SUCCESS;
+	u32 RegVal;
+	int ch, i, n = 0;
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_pm_axi_regs); i++) {
+		u32 mask = xvphy_pm_init_mask(xvphy_pm_axi_regs[i]);
+
+		RegVal = XVphy_ReadReg(InstancePtr->Config.BaseAddr,
+				       xvphy_pm_axi_regs[i]);
+		RegVal = (RegVal & ~mask) | vphydev->pm_axi[i];
+		XVphy_WriteReg(InstancePtr->Config.BaseAddr,
+			       xvphy_pm_axi_regs[i], RegVal);
+	}
+
+	XVphy_ResetGtPll(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
+			 XVPHY_DIR_TX, (TRUE));
+	XVphy_ResetGtPll(InstancePtr, 0, XVPHY_CHANNEL_ID_CHA,
+			 XVPHY_DIR_RX, (TRUE));
+
+	for (i = 0; i < ARRAY_SIZE(xvphy_pm_cmn_drp); i++)
+		Status |= XVphy_DrpWr(InstancePtr, 0, XVPHY_CHANNEL_ID_CMN,
+				      xvphy_pm_cmn_drp[i], vphydev->pm_drp[n++]);
+
+	for (ch = XVPHY_CHANNEL_ID_CH1; ch <= xvphy_pm_last_ch(InstancePtr);
+	     ch++)
+		for (i = 0; i < ARRAY_SIZE(xvphy_pm_ch_drp); i++)
+			Status |= XVphy_DrpWr(InstancePtr, 0, ch,
+					      xvphy_pm_ch_drp[i],
+					      vphydev->pm_drp[n++]);
+
+	xvphy_pm_apply(vphydev);
+	if (!Lock)
+		return Status;
+
+	for (Dir = XVPHY_DIR_RX; Dir <= XVPHY_DIR_TX; Dir++)
+		if (xvphy_pm_dir_used(vphydev, Dir))
+			Status |= xvphy_pm_lock(vphydev, Dir);
+
+	return Status;
+}
+
+static int xvphy_pm_clk_enable(struct xvphy_dev *vphydev)
+{
+	int ret;
+
+	ret = clk_prepare_enable(vphydev->axi_lite_clk);
+	if (ret) {
+		dev_err(vphydev->dev, "failed to enable axi-lite clk\n");
+		return ret;
+	}
+	ret = clk_prepare_enable(vphydev->drp_clk);
+	if (ret) {
+		dev_err(vphydev->dev, "failed to enable drp clk\n");
+		clk_disable_unprepare(vphydev->axi_lite_clk);
+		return ret;
+	}
+
+	return 0;
+}
+
+static void xvphy_pm_clk_disable(struct xvphy_dev *vphydev)
+{
+	clk_disable_unprepare(vphydev->drp_clk);
+	clk_disable_unprepare(vphydev->axi_lite_clk);
+}
+
+static int __maybe_unused xvphy_suspend(struct device *dev)
+{
+	bool rpm_suspended = pm_runtime_status_suspended(dev);
+	int ret;
+
+	if (!vphydev)
+		return 0;
+
+	/* a runtime suspended GT keeps its DRP content but has no clocks */
+	if (rpm_suspended) {
+		ret = xvphy_pm_clk_enable(vphydev);
+		if (ret)
+			return ret;
+	} else {
+		disable_irq(vphydev->irq);
+	}
+
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	ret = xvphy_pm_save(vphydev);
+	vphydev->pm_image_valid = !ret;
+	XVphy_IntrDisable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	if (ret)
+		dev_warn(dev, "DRP image incomplete, full init on resume\n");
+
+	xvphy_pm_clk_disable(vphydev);
+
+	return 0;
+}
+
+static int __maybe_unused xvphy_resume(struct device *dev)
+{
+	XVphy_DirectionType Dir;
+	u32 Status;
+	int ret;
+
+	if (!vphydev)
+		return 0;
+
+	/* replay on the next runtime resume, a lane power on follows it */
+	if (pm_runtime_status_suspended(dev)) {
+		vphydev->pm_replay_pending = true;
+		return 0;
+	}
+
+	ret = xvphy_pm_clk_enable(vphydev);
+	if (ret)
+		return ret;
+
+	if (vphydev->pm_image_valid) {
+		hdmi_mutex_lock(&vphydev->xvphy_mutex);
+		Status = xvphy_pm_restore(vphydev, (TRUE));
+		hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+	} else {
+		Status = XST_FAILURE;
+	}
+
+	if (Status != XST_SUCCESS) {
+		dev_warn(dev, "register replay failed, reconfiguring GT\n");
+		hdmi_mutex_lock(&vphydev->xvphy_mutex);
+		xvphy_pm_apply(vphydev);
+		for (Dir = XVPHY_DIR_RX; Dir <= XVPHY_DIR_TX; Dir++) {
+			if (!xvphy_pm_dir_used(vphydev, Dir))
+				continue;
+			XVphy_ClkInitialize(&vphydev->xvphy, 0,
+					    XVPHY_CHANNEL_ID_CHA, Dir);
+			xvphy_pm_lock(vphydev, Dir);
+		}
+		hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+	}
+
+	XVphy_IntrEnable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
+	enable_irq(vphydev->irq);
+
+	return 0;
+}
+
+static int __maybe_unused xvphy_runtime_suspend(struct device *dev)
+{
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	xvphy_pm_apply(vphydev);
+	XVphy_IntrDisable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	disable_irq(vphydev->irq);
+	xvphy_pm_clk_disable(vphydev);
+
+	return 0;
+}
+
+static int __maybe_unused xvphy_runtime_resume(struct device *dev)
+{
+	u32 Status;
+	int ret;
+
+	ret = xvphy_pm_clk_enable(vphydev);
+	if (ret)
+		return ret;
+
+	hdmi_mutex_lock(&vphydev->xvphy_mutex);
+	if (vphydev->pm_replay_pending) {
+		Status = (vphydev->pm_image_valid) ?
+			 xvphy_pm_restore(vphydev, (FALSE)) : XST_FAILURE;
+		if (Status != XST_SUCCESS)
+			dev_warn(dev, "register replay failed after resume\n");
+		vphydev->pm_replay_pending = false;
+	}
+	xvphy_pm_apply(vphydev);
+	XVphy_IntrEnable(&vphydev->xvphy, XVPHY_DP_INTR_TYPES);
+	hdmi_mutex_unlock(&vphydev->xvphy_mutex);
+
+	enable_irq(vphydev->irq);
+
+	return 0;
+}
+
+static const struct dev_pm_ops xvphy_pm_ops = {
+	SET_SYSTEM_SLEEP_PM_OPS(xvphy_suspend, xvphy_resume)
+	SET_RUNTIME_PM_OPS(xvphy_runtime_suspend, xvphy_runtime_resume, NULL)
+};
+
 /* Match table for of_platform binding */
 static const struct of_device_id xvphy_of_match[] = {
 	{ .compatible = "xlnx,vid-phy-controller-2.2" },
@@ -1295,6 +2709,7 @@ static struct platform_driver xvphy_driver = {
 	.driver = {
 		.name = "xilinx-vphy",
 		.of_match_table	= xvphy_of_match,
+		.pm = &xvphy_pm_ops,
 	},
 };
 module_platform_driver(xvphy_driver);
@@ -46,21 +46,74 @@
 
 /******************************* Include Files ********************************/
 
+#include <linux/mutex.h>
+#include <linux/sort.h>
+#include <linux/string.h>
 #include "xil_assert.h"
 #include "xstatus.h"
 #include "xvidc.h"
+#include "xvidc_cvt.h"
+
+/************************** Constant Definitions ******************************/
+
+/* Video mode hash index: buckets are selected by the mode key without its
+ * reduced blanking class, so that lookups with and without a blanking class
+ * each take a single probe. */
+#define XVIDC_MODE_HASH_BITS	10
+#define XVIDC_MODE_HASH_SIZE	(1 << XVIDC_MODE_HASH_BITS)
+#define XVIDC_MODE_HASH_NONE	0xFFFF
+#define XVIDC_MODE_HASH_NODES	(XVIDC_VM_NUM_SUPPORTED + \
+					XVIDC_MAX_CUSTOM_MODES)
+
+#define XVIDC_MODE_SIG_WORDS	3
+
+#define XVIDC_MODE_KEY_RB_MASK	0x3ULL
+#define XVIDC_MODE_KEY_ANY_RB	(~XVIDC_MODE_KEY_RB_MASK)
+#define XVIDC_MODE_KEY_EXACT	(~0ULL)
 
 /*************************** Variable Declarations ****************************/
 extern const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED];
 
-const XVidC_VideoTimingMode *XVidC_CustomTimingModes = NULL;
-int XVidC_NumCustomModes = 0;
+/* Registered custom video modes, copied and kept sorted by ID. */
+static XVidC_VideoTimingMode XVidC_CustomTimingModes[XVIDC_MAX_CUSTOM_MODES];
+static u16 XVidC_NumCustomModes;
+
+/* The hash index nodes are kept as parallel arrays: a lookup walks the keys,
+ * links and packed blanking signatures, and only dereferences the timing
+ * mode (and its name) of the entry it returns. */
+static u16 XVidC_ModeHashHead[XVIDC_MODE_HASH_SIZE];
+static u64 XVidC_ModeHashKey[XVIDC_MODE_HASH_NODES];
+static u64 XVidC_ModeHashSig[XVIDC_MODE_HASH_NODES][XVIDC_MODE_SIG_WORDS];
+static u16 XVidC_ModeHashNext[XVIDC_MODE_HASH_NODES];
+static const XVidC_VideoTimingMode *XVidC_ModeHashVm[XVIDC_MODE_HASH_NODES];
+static u16 XVidC_ModeHashNumNodes;
+static u8 XVidC_ModeHashReady;
+
+/* Serializes the custom video modes and the hash index: registration
+ * rebuilds the index, which lookups must not walk half built. */
+static DEFINE_MUTEX(XVidC_ModeLock);
 
 /**************************** Function Prototypes *****************************/
 
 static const XVidC_VideoTimingMode *XVidC_GetCustomVideoModeData(
 		XVidC_VideoMode VmId);
-static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN);
+static int XVidC_CustomModeCmp(const void *A, const void *B);
+static u8 XVidC_FindCustomMode(XVidC_VideoMode VmId, u16 *PosPtr);
+static XVidC_VideoMode XVidC_FindCustomTiming(
+		const XVidC_VideoTimingMode *VmPtr);
+static u64 XVidC_ModeKey(u32 Width, u32 Height, u32 FrameRate,
+		u8 IsInterlaced, u8 RbN);
+static void XVidC_ModeHashBuild(void);
+static void XVidC_ModeHashInsertCustom(const XVidC_VideoTimingMode *VmPtr);
+static void XVidC_ModeHashRemoveCustom(const XVidC_VideoTimingMode *VmPtr);
+static void XVidC_ModeHashShiftCustom(const XVidC_VideoTimingMode *FromPtr,
+		int Delta);
+static XVidC_VideoMode XVidC_ModeHashFind(u64 Key, u64 Mask,
+		const XVidC_VideoTiming *Timing, u8 IsInterlaced);
+static XVidC_VideoMode XVidC_ModeHashLookup(u64 Key, u64 Mask,
+		const XVidC_VideoTiming *Timing, u8 IsInterlaced);
+static void XVidC_ModeSig(const XVidC_VideoTiming *Timing,
+		u64 Sig[XVIDC_MODE_SIG_WORDS]);
 
 /*************************** Function Definitions *****************************/
 
@@ -68,8 +121,8 @@ static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN);
 /**
  * This function registers a user-defined custom video mode timing table with
  * video_common. Functions which search the available video modes, or take VmId
- * as an input, will operate on or check the custom video mode timing table in
- * addition to the pre-defined video mode timing table (XVidC_VideoTimingModes).
+ * as an input, will operate on or check the custom video modes in addition to
+ * the pre-defined video mode timing table (XVidC_VideoTimingModes).
  *
  * @param	CustomTable is a pointer to the user-defined custom vide mode
  *		timing table to register.
@@ -77,10 +130,15 @@ static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN);
  *
  * @return
  *		- XST_SUCCESS if the custom table was successfully registered.
- *		- XST_FAILURE if an existing custom table is already present.
+ *		- XST_FAILURE if custom modes are already registered, if the
+ *		  table holds more than XVIDC_MAX_CUSTOM_MODES modes, or if two
+ *		  of its modes share an ID or a timing.
  *
- * @note	IDs in the custom table may not conflict with IDs reserved by
- *		the XVidC_VideoMode enum.
+ * @note	The table is copied and sorted by ID, so it need not outlive
+ *		this call. IDs in the custom table may not conflict with IDs
+ *		reserved by the XVidC_VideoMode enum. Reduced blanking modes have
+ *		to carry their XVIDC_VM_FLAG_RB* flag. The video mode hash index
+ *		is rebuilt here, under the lock video mode lookups take.
  *
 *******************************************************************************/
 u32 XVidC_RegisterCustomTimingModes(const XVidC_VideoTimingMode *CustomTable,
@@ -92,25 +150,55 @@ u32 XVidC_RegisterCustomTimingModes(const XVidC_VideoTimingMode *CustomTable,
 	Xil_AssertNonvoid(CustomTable != NULL);
 	for (Index = 0; Index < NumElems; Index++) {
 		Xil_AssertNonvoid((CustomTable[Index].VmId > XVIDC_VM_CUSTOM));
+		Xil_AssertNonvoid((CustomTable[Index].VmId < XVIDC_VM_CVT_FIRST));
 		/* The IDs of each video mode in the custom table must not
 		 * conflict with IDs reserved by video_common. */
 	}
 
+	if (NumElems > XVIDC_MAX_CUSTOM_MODES) {
+		return XST_FAILURE;
+	}
+
+	mutex_lock(&XVidC_ModeLock);
+
 	/* Fail if a custom table is currently already registered. */
-	if (XVidC_CustomTimingModes) {
+	if (XVidC_NumCustomModes) {
+		mutex_unlock(&XVidC_ModeLock);
 		return XST_FAILURE;
 	}
 
-	XVidC_CustomTimingModes = CustomTable;
-	XVidC_NumCustomModes    = NumElems;
+	memcpy(XVidC_CustomTimingModes, CustomTable,
+			NumElems * sizeof(XVidC_VideoTimingMode));
+	sort(XVidC_CustomTimingModes, NumElems, sizeof(XVidC_VideoTimingMode),
+			XVidC_CustomModeCmp, NULL);
+	XVidC_NumCustomModes = NumElems;
+
+	XVidC_ModeHashBuild();
+
+	/* Reject duplicate IDs, which end up adjacent, and duplicate timings,
+	 * for which the index returns the first of the custom modes. */
+	for (Index = 0; Index < NumElems; Index++) {
+		if (((Index > 0) && (XVidC_CustomTimingModes[Index].VmId ==
+				XVidC_CustomTimingModes[Index - 1].VmId)) ||
+				(XVidC_FindCustomTiming(
+					&XVidC_CustomTimingModes[Index]) !=
+				 XVidC_CustomTimingModes[Index].VmId)) {
+			XVidC_NumCustomModes = 0;
+			XVidC_ModeHashBuild();
+			mutex_unlock(&XVidC_ModeLock);
+			return XST_FAILURE;
+		}
+	}
+
+	mutex_unlock(&XVidC_ModeLock);
 
 	return XST_SUCCESS;
 }
 
 /******************************************************************************/
 /**
- * This function unregisters the user-defined custom video mode timing table
- * previously registered by XVidC_RegisterCustomTimingModes().
+ * This function unregisters all custom video modes previously registered by
+ * XVidC_RegisterCustomTimingModes() or XVidC_AddCustomTimingMode().
  *
  * @return	None.
  *
@@ -119,8 +207,108 @@ u32 XVidC_RegisterCustomTimingModes(const XVidC_VideoTimingMode *CustomTable,
 *******************************************************************************/
 void XVidC_UnregisterCustomTimingModes(void)
 {
-	XVidC_CustomTimingModes = NULL;
-	XVidC_NumCustomModes    = 0;
+	mutex_lock(&XVidC_ModeLock);
+	XVidC_NumCustomModes = 0;
+	XVidC_ModeHashBuild();
+	mutex_unlock(&XVidC_ModeLock);
+}
+
+/******************************************************************************/
+/**
+ * This function adds a single custom video mode to the registered ones.
+ *
+ * @param	VmPtr is a pointer to the custom video mode to add.
+ *
+ * @return
+ *		- XST_SUCCESS if the video mode was added.
+ *		- XST_FAILURE if XVIDC_MAX_CUSTOM_MODES modes are registered, or
+ *		  if a custom mode with the same ID or timing is registered.
+ *
+ * @note	The mode is copied and linked into the video mode hash index.
+ *		The video mode indices of custom modes shift, so a capability
+ *		set decoded from an EDID has to be decoded again.
+ *
+*******************************************************************************/
+u32 XVidC_AddCustomTimingMode(const XVidC_VideoTimingMode *VmPtr)
+{
+	u16 Pos;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(VmPtr != NULL);
+	Xil_AssertNonvoid(VmPtr->VmId > XVIDC_VM_CUSTOM);
+	Xil_AssertNonvoid(VmPtr->VmId < XVIDC_VM_CVT_FIRST);
+
+	mutex_lock(&XVidC_ModeLock);
+
+	if (!XVidC_ModeHashReady) {
+		XVidC_ModeHashBuild();
+	}
+	if ((XVidC_NumCustomModes >= XVIDC_MAX_CUSTOM_MODES) ||
+			XVidC_FindCustomMode(VmPtr->VmId, &Pos) ||
+			(XVidC_FindCustomTiming(VmPtr) !=
+			 XVIDC_VM_NOT_SUPPORTED)) {
+		mutex_unlock(&XVidC_ModeLock);
+		return XST_FAILURE;
+	}
+
+	memmove(&XVidC_CustomTimingModes[Pos + 1],
+			&XVidC_CustomTimingModes[Pos],
+			(XVidC_NumCustomModes - Pos) *
+			sizeof(XVidC_VideoTimingMode));
+	memcpy(&XVidC_CustomTimingModes[Pos], VmPtr,
+			sizeof(XVidC_VideoTimingMode));
+	XVidC_NumCustomModes++;
+
+	XVidC_ModeHashShiftCustom(&XVidC_CustomTimingModes[Pos], 1);
+	XVidC_ModeHashInsertCustom(&XVidC_CustomTimingModes[Pos]);
+
+	mutex_unlock(&XVidC_ModeLock);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function removes a single custom video mode from the registered ones.
+ *
+ * @param	VmId specifies the ID of the custom video mode to remove.
+ *
+ * @return
+ *		- XST_SUCCESS if the video mode was removed.
+ *		- XST_FAILURE if no custom mode has that ID.
+ *
+ * @note	The mode is unlinked from the video mode hash index. The video
+ *		mode indices of custom modes shift, so a capability set decoded
+ *		from an EDID has to be decoded again.
+ *
+*******************************************************************************/
+u32 XVidC_RemoveCustomTimingMode(XVidC_VideoMode VmId)
+{
+	u16 Pos;
+
+	mutex_lock(&XVidC_ModeLock);
+
+	if (!XVidC_FindCustomMode(VmId, &Pos)) {
+		mutex_unlock(&XVidC_ModeLock);
+		return XST_FAILURE;
+	}
+
+	/* Without an index there is nothing to unlink, it is built later. */
+	if (XVidC_ModeHashReady) {
+		XVidC_ModeHashRemoveCustom(&XVidC_CustomTimingModes[Pos]);
+		XVidC_ModeHashShiftCustom(&XVidC_CustomTimingModes[Pos + 1],
+				-1);
+	}
+
+	XVidC_NumCustomModes--;
+	memmove(&XVidC_CustomTimingModes[Pos],
+			&XVidC_CustomTimingModes[Pos + 1],
+			(XVidC_NumCustomModes - Pos) *
+			sizeof(XVidC_VideoTimingMode));
+
+	mutex_unlock(&XVidC_ModeLock);
+
+	return XST_SUCCESS;
 }
 
 /******************************************************************************/
@@ -136,9 +324,9 @@ void XVidC_UnregisterCustomTimingModes(void)
  * @note	None.
  *
 *******************************************************************************/
-u32 XVidC_GetPixelClockHzByHVFr(u32 HTotal, u32 VTotal, u8 FrameRate)
+u64 XVidC_GetPixelClockHzByHVFr(u32 HTotal, u32 VTotal, u8 FrameRate)
 {
-	return (HTotal * VTotal * FrameRate);
+	return (u64)HTotal * VTotal * FrameRate;
 }
 
 /******************************************************************************/
@@ -147,43 +335,108 @@ u32 XVidC_GetPixelClockHzByHVFr(u32 HTotal, u32 VTotal, u8 FrameRate)
  *
  * @param	VmId specifies the resolution id.
  *
- * @return	Pixel clock in Hz.
+ * @return	Pixel clock in Hz, rounded to the nearest Hz.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u64 XVidC_GetPixelClockHzByVmId(XVidC_VideoMode VmId)
+{
+	return (XVidC_GetPixelClockMilliHzByVmId(VmId) + 500) / 1000;
+}
+
+/******************************************************************************/
+/**
+ * This function calculates pixel clock based on the inputs, with millihertz
+ * precision.
+ *
+ * @param	HTotal specifies horizontal total.
+ * @param	VTotal specifies vertical total.
+ * @param	FrameRateMilliHz specifies rate at which frames are generated,
+ *		in millihertz.
+ *
+ * @return	Pixel clock in millihertz.
  *
  * @note	None.
  *
 *******************************************************************************/
-u32 XVidC_GetPixelClockHzByVmId(XVidC_VideoMode VmId)
+u64 XVidC_GetPixelClockMilliHzByHVFr(u32 HTotal, u32 VTotal,
+		u32 FrameRateMilliHz)
+{
+	return (u64)HTotal * VTotal * FrameRateMilliHz;
+}
+
+/******************************************************************************/
+/**
+ * This function calculates pixel clock from video mode, with millihertz
+ * precision.
+ *
+ * @param	VmId specifies the resolution id.
+ *
+ * @return	Pixel clock in millihertz, or 0 if the mode is not found.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u64 XVidC_GetPixelClockMilliHzByVmId(XVidC_VideoMode VmId)
 {
-	u32 ClkHz;
 	const XVidC_VideoTimingMode *VmPtr;
+	u32 FrameRateMilliHz;
 
 	VmPtr = XVidC_GetVideoModeData(VmId);
 	if (!VmPtr) {
 		return 0;
 	}
 
+	FrameRateMilliHz = VmPtr->FrameRateMilliHz ? VmPtr->FrameRateMilliHz :
+		XVIDC_FR_MILLIHZ(VmPtr->FrameRate);
+
 	if (XVidC_IsInterlaced(VmId)) {
 		/* For interlaced mode, use both frame 0 and frame 1 vertical
-		 * totals. */
-		ClkHz = VmPtr->Timing.F0PVTotal + VmPtr->Timing.F1VTotal;
-
-		/* Multiply the number of pixels by the frame rate of each
-		 * individual frame (half of the total frame rate). */
-		ClkHz *= VmPtr->FrameRate / 2;
+		 * totals, each at half of the total frame rate. */
+		return XVidC_GetPixelClockMilliHzByHVFr(VmPtr->Timing.HTotal,
+				VmPtr->Timing.F0PVTotal +
+				VmPtr->Timing.F1VTotal,
+				FrameRateMilliHz) / 2;
 	}
-	else {
-		/* For progressive mode, use only frame 0 vertical total. */
-		ClkHz = VmPtr->Timing.F0PVTotal;
 
-		/* Multiply the number of pixels by the frame rate. */
-		ClkHz *= VmPtr->FrameRate;
-	}
+	/* For progressive mode, use only frame 0 vertical total. */
+	return XVidC_GetPixelClockMilliHzByHVFr(VmPtr->Timing.HTotal,
+			VmPtr->Timing.F0PVTotal, FrameRateMilliHz);
+}
 
-	/* Multiply the vertical total by the horizontal total for number of
-	 * pixels. */
-	ClkHz *= VmPtr->Timing.HTotal;
+/******************************************************************************/
+/**
+ * This function calculates pixel clock of a video stream from its timing, with
+ * millihertz precision.
+ *
+ * @param	Stream is a pointer to the video stream.
+ *
+ * @return	Pixel clock in millihertz.
+ *
+ * @note	The stream timing and frame rate are used as-is, so this also
+ *		works for custom streams.
+ *
+*******************************************************************************/
+u64 XVidC_GetPixelClockMilliHzByStream(const XVidC_VideoStream *Stream)
+{
+	u32 FrameRateMilliHz;
 
-	return ClkHz;
+	/* Verify argument. */
+	Xil_AssertNonvoid(Stream != NULL);
+
+	FrameRateMilliHz = Stream->FrameRateMilliHz ? Stream->FrameRateMilliHz :
+		XVIDC_FR_MILLIHZ(Stream->FrameRate);
+
+	if (Stream->IsInterlaced) {
+		return XVidC_GetPixelClockMilliHzByHVFr(Stream->Timing.HTotal,
+				Stream->Timing.F0PVTotal +
+				Stream->Timing.F1VTotal,
+				FrameRateMilliHz) / 2;
+	}
+
+	return XVidC_GetPixelClockMilliHzByHVFr(Stream->Timing.HTotal,
+			Stream->Timing.F0PVTotal, FrameRateMilliHz);
 }
 
 /******************************************************************************/
@@ -313,106 +566,13 @@ XVidC_VideoMode XVidC_GetVideoModeIdWBlanking(const XVidC_VideoTiming *Timing,
 XVidC_VideoMode XVidC_GetVideoModeId(u32 Width, u32 Height, u32 FrameRate,
 					u8 IsInterlaced)
 {
-	u32 Low;
-	u32 High;
-	u32 Mid;
-	u32 HActive;
-	u32 VActive;
-	u32 Rate;
-	u32 ResFound = (FALSE);
-	XVidC_VideoMode Mode;
-	u16 Index;
+	u64 Key;
 
-	/* First, attempt a linear search on the custom video timing table. */
-	if(XVidC_CustomTimingModes) {
-	  for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
-		HActive = XVidC_CustomTimingModes[Index].Timing.HActive;
-		VActive = XVidC_CustomTimingModes[Index].Timing.VActive;
-		Rate = XVidC_CustomTimingModes[Index].FrameRate;
-		if ((Width  == HActive) &&
-			(Height == VActive) &&
-			(FrameRate == Rate)) {
-			   return XVidC_CustomTimingModes[Index].VmId;
-		}
-	  }
-	}
+	/* Custom modes are ahead of the built-in ones in each hash chain. */
+	Key = XVidC_ModeKey(Width, Height, FrameRate, IsInterlaced, 0);
 
-	if (IsInterlaced) {
-		Low = (XVIDC_VM_INTL_START);
-		High = (XVIDC_VM_INTL_END);
-	}
-	else {
-		Low = (XVIDC_VM_PROG_START);
-		High = (XVIDC_VM_PROG_END);
-	}
-
-	HActive = VActive = Rate = 0;
-
-	/* Binary search finds item in sorted array.
-	 * And returns index (zero based) of item
-	 * If item is not found returns flag remains
-	 * FALSE. Search key is "width or HActive"
-	 */
-	while (Low <= High) {
-		Mid = (Low + High) / 2;
-		HActive = XVidC_VideoTimingModes[Mid].Timing.HActive;
-		if (Width == HActive) {
-			ResFound = (TRUE);
-			break;
-		}
-		else if (Width < HActive) {
-			if (Mid == 0) {
-				break;
-			}
-			else {
-				High = Mid - 1;
-			}
-		}
-		else {
-			Low = Mid + 1;
-		}
-	}
-
-	 /* HActive matched at middle */
-	if (ResFound) {
-		/* Rewind to start index of mode with matching width */
-		while ((Mid > 0) &&
-			(XVidC_VideoTimingModes[Mid - 1].Timing.HActive ==
-								Width)) {
-			--Mid;
-		}
-
-		ResFound = (FALSE);
-		VActive = XVidC_VideoTimingModes[Mid].Timing.VActive;
-		Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-
-		/* Now do a linear search for matching VActive and Frame
-		 * Rate
-		 */
-		while (HActive == Width) {
-			/* check current entry */
-			if ((VActive == Height) && (Rate == FrameRate)) {
-				ResFound = (TRUE);
-				break;
-			}
-			/* Check next entry */
-			else {
-				Mid = Mid + 1;
-				HActive =
-				XVidC_VideoTimingModes[Mid].Timing.HActive;
-				VActive =
-				XVidC_VideoTimingModes[Mid].Timing.VActive;
-				Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-			}
-		}
-		Mode =
-		(ResFound) ? (XVidC_VideoMode)Mid : (XVIDC_VM_NOT_SUPPORTED);
-	}
-	else {
-		Mode = (XVIDC_VM_NOT_SUPPORTED);
-	}
-
-	return (Mode);
+	return XVidC_ModeHashLookup(Key, XVIDC_MODE_KEY_ANY_RB, NULL,
+			IsInterlaced);
 }
 
 /******************************************************************************/
@@ -440,149 +600,13 @@ XVidC_VideoMode XVidC_GetVideoModeIdExtensive(XVidC_VideoTiming *Timing,
 											  u8 IsInterlaced,
 											  u8 IsExtensive)
 {
-	u32 Low;
-	u32 High;
-	u32 Mid;
-	u32 HActive;
-	u32 VActive;
-	u32 Rate;
-	u32 ResFound = (FALSE);
-	XVidC_VideoMode Mode;
-	u16 Index;
+	u64 Key;
 
-	/* First, attempt a linear search on the custom video timing table. */
-	if(XVidC_CustomTimingModes) {
-	  for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
-		HActive = XVidC_CustomTimingModes[Index].Timing.HActive;
-		VActive = XVidC_CustomTimingModes[Index].Timing.VActive;
-		Rate = XVidC_CustomTimingModes[Index].FrameRate;
-		if ((HActive == Timing->HActive) && (VActive == Timing->VActive) &&
-				(Rate == FrameRate) && (IsExtensive == 0 || (
-			XVidC_CustomTimingModes[Index].Timing.HTotal == Timing->HTotal &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVTotal ==
-					Timing->F0PVTotal &&
-			XVidC_CustomTimingModes[Index].Timing.HFrontPorch ==
-					Timing->HFrontPorch &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVFrontPorch ==
-					Timing->F0PVFrontPorch &&
-			XVidC_CustomTimingModes[Index].Timing.HSyncWidth ==
-					Timing->HSyncWidth &&
-			XVidC_CustomTimingModes[Index].Timing.F0PVSyncWidth ==
-					Timing->F0PVSyncWidth &&
-			XVidC_CustomTimingModes[Index].Timing.VSyncPolarity ==
-					Timing->VSyncPolarity))) {
-				if (!IsInterlaced || IsExtensive == 0 || (
-						XVidC_CustomTimingModes[Index].Timing.F1VTotal ==
-						Timing->F1VTotal &&
-						XVidC_CustomTimingModes[Index].Timing.F1VFrontPorch ==
-								Timing->F1VFrontPorch &&
-						XVidC_CustomTimingModes[Index].Timing.F1VSyncWidth ==
-								Timing->F1VSyncWidth)) {
-					return XVidC_CustomTimingModes[Index].VmId;
-				}
-		}
-	  }
-	}
+	Key = XVidC_ModeKey(Timing->HActive, Timing->VActive, FrameRate,
+			IsInterlaced, 0);
 
-	if (IsInterlaced) {
-		Low = (XVIDC_VM_INTL_START);
-		High = (XVIDC_VM_INTL_END);
-	}
-	else {
-		Low = (XVIDC_VM_PROG_START);
-		High = (XVIDC_VM_PROG_END);
-	}
-
-	HActive = VActive = Rate = 0;
-
-	/* Binary search finds item in sorted array.
-	 * And returns index (zero based) of item
-	 * If item is not found returns flag remains
-	 * FALSE. Search key is "Timing->HActive or HActive"
-	 */
-	while (Low <= High) {
-		Mid = (Low + High) / 2;
-		HActive = XVidC_VideoTimingModes[Mid].Timing.HActive;
-		if (Timing->HActive == HActive) {
-			ResFound = (TRUE);
-			break;
-		}
-		else if (Timing->HActive < HActive) {
-			if (Mid == 0) {
-				break;
-			}
-			else {
-				High = Mid - 1;
-			}
-		}
-		else {
-			Low = Mid + 1;
-		}
-	}
-
-	 /* HActive matched at middle */
-	if (ResFound) {
-		/* Rewind to start index of mode with matching Timing->HActive */
-		while ((Mid > 0) &&
-			(XVidC_VideoTimingModes[Mid - 1].Timing.HActive ==
-								Timing->HActive)) {
-			--Mid;
-		}
-
-		ResFound = (FALSE);
-		VActive = XVidC_VideoTimingModes[Mid].Timing.VActive;
-		Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-
-		/* Now do a linear search for matching VActive and Frame
-		 * Rate
-		 */
-		while (HActive == Timing->HActive) {
-			/* check current entry */
-			if ((VActive == Timing->VActive) && (Rate == FrameRate) &&
-					(IsExtensive == 0 ||
-					(XVidC_VideoTimingModes[Mid].Timing.HTotal ==
-							Timing->HTotal &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVTotal ==
-							Timing->F0PVTotal &&
-					XVidC_VideoTimingModes[Mid].Timing.HFrontPorch ==
-							Timing->HFrontPorch &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVFrontPorch ==
-							Timing->F0PVFrontPorch &&
-					XVidC_VideoTimingModes[Mid].Timing.HSyncWidth ==
-							Timing->HSyncWidth &&
-					XVidC_VideoTimingModes[Mid].Timing.F0PVSyncWidth ==
-							Timing->F0PVSyncWidth &&
-					XVidC_VideoTimingModes[Mid].Timing.VSyncPolarity ==
-							Timing->VSyncPolarity))) {
-				if (!IsInterlaced || IsExtensive == 0 || (
-						XVidC_VideoTimingModes[Mid].Timing.F1VTotal ==
-								Timing->F1VTotal &&
-						XVidC_VideoTimingModes[Mid].Timing.F1VFrontPorch ==
-								Timing->F1VFrontPorch &&
-						XVidC_VideoTimingModes[Mid].Timing.F1VSyncWidth ==
-								Timing->F1VSyncWidth)) {
-					ResFound = (TRUE);
-					break;
-				}
-			}
-			/* Check next entry */
-			else {
-				Mid = Mid + 1;
-				HActive =
-				XVidC_VideoTimingModes[Mid].Timing.HActive;
-				VActive =
-				XVidC_VideoTimingModes[Mid].Timing.VActive;
-				Rate = XVidC_VideoTimingModes[Mid].FrameRate;
-			}
-		}
-		Mode =
-		(ResFound) ? (XVidC_VideoMode)Mid : (XVIDC_VM_NOT_SUPPORTED);
-	}
-	else {
-		Mode = (XVIDC_VM_NOT_SUPPORTED);
-	}
-
-	return (Mode);
+	return XVidC_ModeHashLookup(Key, XVIDC_MODE_KEY_ANY_RB,
+			IsExtensive ? Timing : NULL, IsInterlaced);
 }
 
 /******************************************************************************/
@@ -609,35 +633,12 @@ XVidC_VideoMode XVidC_GetVideoModeIdExtensive(XVidC_VideoTiming *Timing,
 XVidC_VideoMode XVidC_GetVideoModeIdRb(u32 Width, u32 Height,
 		u32 FrameRate, u8 IsInterlaced, u8 RbN)
 {
-	XVidC_VideoMode VmId;
-	const XVidC_VideoTimingMode *VtmPtr;
-	u8 Found = 0;
+	u64 Key;
 
-	VmId = XVidC_GetVideoModeId(Width, Height, FrameRate,
-				IsInterlaced);
+	Key = XVidC_ModeKey(Width, Height, FrameRate, IsInterlaced, RbN);
 
-	VtmPtr = XVidC_GetVideoModeData(VmId);
-	if (!VtmPtr) {
-		return XVIDC_VM_NOT_SUPPORTED;
-	}
-
-	while (!Found) {
-		VtmPtr = XVidC_GetVideoModeData(VmId);
-		if ((Height != VtmPtr->Timing.VActive) ||
-		    (Width != VtmPtr->Timing.HActive) ||
-		    (FrameRate != VtmPtr->FrameRate) ||
-		    (IsInterlaced && !XVidC_IsInterlaced(VmId))) {
-			VmId = XVIDC_VM_NOT_SUPPORTED;
-			break;
-		}
-		Found = XVidC_IsVtmRb(XVidC_GetVideoModeStr(VmId), RbN);
-		if (Found) {
-			break;
-		}
-		VmId = (XVidC_VideoMode)((int)VmId + 1);
-	}
-
-	return VmId;
+	return XVidC_ModeHashLookup(Key, XVIDC_MODE_KEY_EXACT, NULL,
+			IsInterlaced);
 }
 
 /******************************************************************************/
@@ -657,10 +658,78 @@ const XVidC_VideoTimingMode *XVidC_GetVideoModeData(XVidC_VideoMode VmId)
 	if (VmId < XVIDC_VM_NUM_SUPPORTED) {
 		return &XVidC_VideoTimingModes[VmId];
 	}
+	if (VmId >= XVIDC_VM_CVT_FIRST) {
+		return XVidC_CvtGetVideoModeData(VmId);
+	}
 
 	return XVidC_GetCustomVideoModeData(VmId);
 }
 
+/******************************************************************************/
+/**
+ * This function returns the number of video modes known to video_common: the
+ * built-in video timing table followed by the registered custom table.
+ *
+ * @return	The number of video mode indices.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u16 XVidC_GetNumVideoModes(void)
+{
+	return XVIDC_VM_NUM_SUPPORTED + XVidC_NumCustomModes;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the video mode data at a video mode index.
+ *
+ * @param	Index is the video mode index, below XVidC_GetNumVideoModes().
+ *
+ * @return	Pointer to XVidC_VideoTimingMode structure, or NULL if the
+ *		index is out of range.
+ *
+ * @note	Indices of the built-in modes equal their IDs.
+ *
+*******************************************************************************/
+const XVidC_VideoTimingMode *XVidC_GetVideoModeDataByIndex(u16 Index)
+{
+	if (Index < XVIDC_VM_NUM_SUPPORTED) {
+		return &XVidC_VideoTimingModes[Index];
+	}
+	if (Index < XVidC_GetNumVideoModes()) {
+		return &XVidC_CustomTimingModes[Index - XVIDC_VM_NUM_SUPPORTED];
+	}
+
+	return NULL;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the video mode index of a video mode ID.
+ *
+ * @param	VmId specifies the resolution ID.
+ *
+ * @return	The video mode index, or -1 if the ID is unknown.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+int XVidC_GetVideoModeIndex(XVidC_VideoMode VmId)
+{
+	u16 Pos;
+
+	if (VmId < XVIDC_VM_NUM_SUPPORTED) {
+		return VmId;
+	}
+
+	if (!XVidC_FindCustomMode(VmId, &Pos)) {
+		return -1;
+	}
+
+	return XVIDC_VM_NUM_SUPPORTED + Pos;
+}
+
 /******************************************************************************/
 /**
  *
@@ -843,6 +912,33 @@ XVidC_FrameRate XVidC_GetFrameRate(XVidC_VideoMode VmId)
 	return VmPtr->FrameRate;
 }
 
+/******************************************************************************/
+/**
+ * This function returns the exact frame rate for index specified.
+ *
+ * @param	VmId specifies the resolution id.
+ *
+ * @return	Frame rate in millihertz, or 0 if the mode is not found.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u32 XVidC_GetFrameRateMilliHz(XVidC_VideoMode VmId)
+{
+	const XVidC_VideoTimingMode *VmPtr;
+
+	VmPtr = XVidC_GetVideoModeData(VmId);
+	if (!VmPtr) {
+		return 0;
+	}
+
+	if (VmPtr->FrameRateMilliHz) {
+		return VmPtr->FrameRateMilliHz;
+	}
+
+	return XVIDC_FR_MILLIHZ(VmPtr->FrameRate);
+}
+
 /******************************************************************************/
 /**
  * This function returns the timing parameters for specified resolution.
@@ -913,6 +1009,7 @@ u32 XVidC_SetVideoStream(XVidC_VideoStream *VidStrmPtr, XVidC_VideoMode VmId,
 
 	  VidStrmPtr->Timing		= *TimingPtr;
 	  VidStrmPtr->FrameRate		= XVidC_GetFrameRate(VmId);
+	  VidStrmPtr->FrameRateMilliHz	= XVidC_GetFrameRateMilliHz(VmId);
 	  VidStrmPtr->IsInterlaced	= XVidC_IsInterlaced(VmId);
 	  
 	} else { //Custom Timing - use as-is
@@ -1036,6 +1133,8 @@ u32 XVidC_Set3DVideoStream(XVidC_VideoStream *VidStrmPtr, XVidC_VideoMode VmId,
 *******************************************************************************/
 void XVidC_ReportStreamInfo(const XVidC_VideoStream *Stream)
 {
+	u32 FrameRateMilliHz;
+
 	if (!XVidC_GetVideoModeData(Stream->VmId) &&
 			(Stream->VmId != XVIDC_VM_CUSTOM)) {
 		xil_printf("\tThe stream ID (%d) is not supported.\r\n",
@@ -1056,22 +1155,24 @@ void XVidC_ReportStreamInfo(const XVidC_VideoStream *Stream)
 	}
 
 	if (Stream->VmId == XVIDC_VM_CUSTOM) {
-		xil_printf("\tFrame Rate:       %dHz\r\n",
-				Stream->FrameRate);
+		FrameRateMilliHz = Stream->FrameRateMilliHz ?
+			Stream->FrameRateMilliHz :
+			XVIDC_FR_MILLIHZ(Stream->FrameRate);
+		xil_printf("\tFrame Rate:       %u.%03uHz\r\n",
+				FrameRateMilliHz / 1000,
+				FrameRateMilliHz % 1000);
 		xil_printf("\tResolution:       %dx%d [Custom Mode]\r\n",
 				Stream->Timing.HActive, Stream->Timing.VActive);
-		xil_printf("\tPixel Clock:      %d\r\n",
-				XVidC_GetPixelClockHzByHVFr(
-					Stream->Timing.HTotal,
-					Stream->Timing.F0PVTotal,
-					Stream->FrameRate));
+		xil_printf("\tPixel Clock:      %llu\r\n",
+				(XVidC_GetPixelClockMilliHzByStream(Stream) +
+				 500) / 1000);
 	}
 	else {
 		xil_printf("\tFrame Rate:       %s\r\n",
 				XVidC_GetFrameRateStr(Stream->VmId));
 		xil_printf("\tResolution:       %s\r\n",
 				XVidC_GetVideoModeStr(Stream->VmId));
-		xil_printf("\tPixel Clock:      %d\r\n",
+		xil_printf("\tPixel Clock:      %llu\r\n",
 				XVidC_GetPixelClockHzByVmId(Stream->VmId));
 	}
 }
@@ -1122,13 +1223,12 @@ void XVidC_ReportTiming(const XVidC_VideoTiming *Timing, u8 IsInterlaced)
 
 /******************************************************************************/
 /**
- * This function returns the pointer to video mode data at the provided index
- * of the custom video mode table.
+ * This function returns the pointer to the data of a custom video mode.
  *
  * @param	VmId specifies the resolution ID.
  *
  * @return	Pointer to XVidC_VideoTimingMode structure based on the given
- *		video mode.
+ *		video mode, or NULL if no custom mode has that ID.
  *
  * @note	None.
  *
@@ -1136,49 +1236,443 @@ void XVidC_ReportTiming(const XVidC_VideoTiming *Timing, u8 IsInterlaced)
 static const XVidC_VideoTimingMode *XVidC_GetCustomVideoModeData(
 		XVidC_VideoMode VmId)
 {
-	u16 Index;
+	u16 Pos;
+
+	if (!XVidC_FindCustomMode(VmId, &Pos)) {
+		/* ID not found within the custom video modes. */
+		return NULL;
+	}
+
+	return &XVidC_CustomTimingModes[Pos];
+}
 
-	for (Index = 0; Index < XVidC_NumCustomModes; Index++) {
-		if (VmId == (XVidC_CustomTimingModes[Index].VmId)) {
-			return &(XVidC_CustomTimingModes[Index]);
+/******************************************************************************/
+/**
+ * This function orders custom video modes by ID, for sort().
+ *
+ * @param	A is a pointer to the first video timing mode.
+ * @param	B is a pointer to the second video timing mode.
+ *
+ * @return	<0, 0 or >0 as the ID of A is below, equal to or above B's.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static int XVidC_CustomModeCmp(const void *A, const void *B)
+{
+	XVidC_VideoMode IdA = ((const XVidC_VideoTimingMode *)A)->VmId;
+	XVidC_VideoMode IdB = ((const XVidC_VideoTimingMode *)B)->VmId;
+
+	return (IdA > IdB) - (IdA < IdB);
+}
+
+/******************************************************************************/
+/**
+ * This function binary searches the custom video modes for an ID.
+ *
+ * @param	VmId specifies the resolution ID.
+ * @param	PosPtr is set to the position of the mode, or to the position
+ *		it would be inserted at if it is not registered.
+ *
+ * @return	TRUE if the ID was found, FALSE otherwise.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u8 XVidC_FindCustomMode(XVidC_VideoMode VmId, u16 *PosPtr)
+{
+	u16 Low = 0;
+	u16 High = XVidC_NumCustomModes;
+	u16 Mid;
+
+	while (Low < High) {
+		Mid = Low + (High - Low) / 2;
+		if (XVidC_CustomTimingModes[Mid].VmId < VmId) {
+			Low = Mid + 1;
+		}
+		else {
+			High = Mid;
 		}
 	}
 
-	/* ID not found within the custom video mode table. */
-	return NULL;
+	*PosPtr = Low;
+
+	return (Low < XVidC_NumCustomModes) &&
+		(XVidC_CustomTimingModes[Low].VmId == VmId);
 }
 
 /******************************************************************************/
 /**
- * This function returns whether or not the video timing mode is a reduced
- * blanking mode or not.
+ * This function looks up the custom video mode that has the same timing as a
+ * video timing mode.
  *
- * @param	VideoModeStr specifies the resolution name string.
- * @param	RbN specifies the type of reduced blanking:
- *		- 0 = No Reduced Blanking
- *		- 1 = RB
- *		- 2 = RB2
+ * @param	VmPtr is a pointer to the video timing mode.
+ *
+ * @return	ID of the first custom mode with the same active size, frame
+ *		rate, reduced blanking class and blanking, or
+ *		XVIDC_VM_NOT_SUPPORTED.
+ *
+ * @note	Must be called with XVidC_ModeLock held and the index built.
+ *
+*******************************************************************************/
+static XVidC_VideoMode XVidC_FindCustomTiming(
+		const XVidC_VideoTimingMode *VmPtr)
+{
+	XVidC_VideoMode VmId;
+	u8 IsInterlaced = VmPtr->Timing.F1VTotal != 0;
+
+	VmId = XVidC_ModeHashFind(XVidC_ModeKey(VmPtr->Timing.HActive,
+			VmPtr->Timing.VActive, VmPtr->FrameRate, IsInterlaced,
+			XVidC_GetVtmRbClass(VmPtr)), XVIDC_MODE_KEY_EXACT,
+			&VmPtr->Timing, IsInterlaced);
+
+	return (VmId > XVIDC_VM_CUSTOM) ? VmId : XVIDC_VM_NOT_SUPPORTED;
+}
+
+/******************************************************************************/
+/**
+ * This function packs the attributes a video mode is looked up by into a
+ * video mode hash index key.
  *
- * @return	If the reduced blanking type is compatible with the video mode:
- *		- 0 = Not supported
- *		- 1 = Video mode supports the RB type
+ * @param	Width specifies the number pixels per scanline.
+ * @param	Height specifies the number of scanline's.
+ * @param	FrameRate specifies refresh rate in HZ.
+ * @param	IsInterlaced specifies interlaced or progressive mode.
+ * @param	RbN specifies the type of reduced blanking.
+ *
+ * @return	The video mode key.
  *
  * @note	None.
  *
 *******************************************************************************/
-static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN)
+static u64 XVidC_ModeKey(u32 Width, u32 Height, u32 FrameRate,
+		u8 IsInterlaced, u8 RbN)
+{
+	return ((u64)(Width & 0xFFFF) << 32) | ((u64)(Height & 0xFFFF) << 16) |
+		((u64)(FrameRate & 0x1FFF) << 3) | ((IsInterlaced ? 1 : 0) << 2) |
+		(RbN & XVIDC_MODE_KEY_RB_MASK);
+}
+
+/******************************************************************************/
+/**
+ * This function returns the video mode hash index bucket of a video mode key.
+ *
+ * @param	Key is the video mode key.
+ *
+ * @return	The bucket index.
+ *
+ * @note	The reduced blanking class does not take part in the hash.
+ *
+*******************************************************************************/
+static inline u32 XVidC_ModeHash(u64 Key)
 {
-	while ((*VideoModeStr !='\0') && (*VideoModeStr != 'R')) {
-		VideoModeStr++;
+	return (u32)(((Key & XVIDC_MODE_KEY_ANY_RB) * 0x9E3779B97F4A7C15ULL) >>
+			(64 - XVIDC_MODE_HASH_BITS));
+}
+
+/******************************************************************************/
+/**
+ * This function fills in a new video mode hash index node.
+ *
+ * @param	VmPtr is a pointer to the video timing mode.
+ *
+ * @return	The node, not linked into a chain yet.
+ *
+ * @note	Must be called with XVidC_ModeLock held.
+ *
+*******************************************************************************/
+static u16 XVidC_ModeHashNewNode(const XVidC_VideoTimingMode *VmPtr)
+{
+	u16 Node = XVidC_ModeHashNumNodes++;
+
+	XVidC_ModeHashKey[Node] = XVidC_ModeKey(VmPtr->Timing.HActive,
+			VmPtr->Timing.VActive, VmPtr->FrameRate,
+			VmPtr->Timing.F1VTotal != 0, XVidC_GetVtmRbClass(VmPtr));
+	XVidC_ModeSig(&VmPtr->Timing, XVidC_ModeHashSig[Node]);
+	XVidC_ModeHashVm[Node] = VmPtr;
+
+	return Node;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the link pointing to a video mode hash index node.
+ *
+ * @param	Node is a node linked into its chain.
+ *
+ * @return	A pointer to the bucket head or the link of the node before.
+ *
+ * @note	Must be called with XVidC_ModeLock held.
+ *
+*******************************************************************************/
+static u16 *XVidC_ModeHashLinkTo(u16 Node)
+{
+	u16 *LinkPtr = &XVidC_ModeHashHead[XVidC_ModeHash(
+			XVidC_ModeHashKey[Node])];
+
+	while (*LinkPtr != Node) {
+		LinkPtr = &XVidC_ModeHashNext[*LinkPtr];
 	}
 
-	if (*(VideoModeStr + 2) == ')') {
-		return RbN == 1;
+	return LinkPtr;
+}
+
+/******************************************************************************/
+/**
+ * This function adds a video timing mode to the head of its video mode hash
+ * index chain.
+ *
+ * @param	VmPtr is a pointer to the video timing mode.
+ *
+ * @return	None.
+ *
+ * @note	Must be called with XVidC_ModeLock held.
+ *
+*******************************************************************************/
+static void XVidC_ModeHashInsert(const XVidC_VideoTimingMode *VmPtr)
+{
+	u16 Node = XVidC_ModeHashNewNode(VmPtr);
+	u32 Bucket = XVidC_ModeHash(XVidC_ModeHashKey[Node]);
+
+	XVidC_ModeHashNext[Node] = XVidC_ModeHashHead[Bucket];
+	XVidC_ModeHashHead[Bucket] = Node;
+}
+
+/******************************************************************************/
+/**
+ * This function links a registered custom video mode into its video mode
+ * hash index chain.
+ *
+ * @param	VmPtr is a pointer to the custom mode in the custom table.
+ *
+ * @return	None.
+ *
+ * @note	The mode goes after the custom modes with a lower ID, keeping
+ *		the chain in the order XVidC_ModeHashBuild() gives it. Nodes of
+ *		custom modes follow those of the built-in table. Must be called
+ *		with XVidC_ModeLock held and the index built.
+ *
+*******************************************************************************/
+static void XVidC_ModeHashInsertCustom(const XVidC_VideoTimingMode *VmPtr)
+{
+	u16 Node = XVidC_ModeHashNewNode(VmPtr);
+	u16 *LinkPtr = &XVidC_ModeHashHead[XVidC_ModeHash(
+			XVidC_ModeHashKey[Node])];
+
+	while ((*LinkPtr != XVIDC_MODE_HASH_NONE) &&
+			(*LinkPtr >= XVIDC_VM_NUM_SUPPORTED) &&
+			(XVidC_ModeHashVm[*LinkPtr]->VmId < VmPtr->VmId)) {
+		LinkPtr = &XVidC_ModeHashNext[*LinkPtr];
 	}
-	if (*(VideoModeStr + 2) == '2') {
-		return RbN == 2;
+
+	XVidC_ModeHashNext[Node] = *LinkPtr;
+	*LinkPtr = Node;
+}
+
+/******************************************************************************/
+/**
+ * This function unlinks a registered custom video mode from the video mode
+ * hash index.
+ *
+ * @param	VmPtr is a pointer to the custom mode in the custom table.
+ *
+ * @return	None.
+ *
+ * @note	The last node moves into the freed one, keeping the nodes
+ *		dense. Must be called with XVidC_ModeLock held and the index
+ *		built.
+ *
+*******************************************************************************/
+static void XVidC_ModeHashRemoveCustom(const XVidC_VideoTimingMode *VmPtr)
+{
+	u16 Node;
+	u16 Last;
+
+	for (Node = XVIDC_VM_NUM_SUPPORTED; Node < XVidC_ModeHashNumNodes;
+			Node++) {
+		if (XVidC_ModeHashVm[Node] == VmPtr) {
+			break;
+		}
 	}
-	return 0;
+	if (Node == XVidC_ModeHashNumNodes) {
+		return;
+	}
+
+	*XVidC_ModeHashLinkTo(Node) = XVidC_ModeHashNext[Node];
+
+	Last = --XVidC_ModeHashNumNodes;
+	if (Node != Last) {
+		*XVidC_ModeHashLinkTo(Last) = Node;
+		XVidC_ModeHashKey[Node] = XVidC_ModeHashKey[Last];
+		memcpy(XVidC_ModeHashSig[Node], XVidC_ModeHashSig[Last],
+				sizeof(XVidC_ModeHashSig[Node]));
+		XVidC_ModeHashNext[Node] = XVidC_ModeHashNext[Last];
+		XVidC_ModeHashVm[Node] = XVidC_ModeHashVm[Last];
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function follows custom video modes moved within the custom table.
+ *
+ * @param	FromPtr is a pointer to the first custom table entry moved.
+ * @param	Delta is the number of entries the modes moved by.
+ *
+ * @return	None.
+ *
+ * @note	Must be called with XVidC_ModeLock held.
+ *
+*******************************************************************************/
+static void XVidC_ModeHashShiftCustom(const XVidC_VideoTimingMode *FromPtr,
+		int Delta)
+{
+	u16 Node;
+
+	for (Node = XVIDC_VM_NUM_SUPPORTED; Node < XVidC_ModeHashNumNodes;
+			Node++) {
+		if (XVidC_ModeHashVm[Node] >= FromPtr) {
+			XVidC_ModeHashVm[Node] += Delta;
+		}
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function (re)builds the video mode hash index over the built-in video
+ * timing table and the registered custom video timing table.
+ *
+ * @return	None.
+ *
+ * @note	Modes are inserted last to first so that each chain lists the
+ *		custom modes first and then the built-in modes in table order,
+ *		which is the order the linear searches used to match in. Must
+ *		be called with XVidC_ModeLock held.
+ *
+*******************************************************************************/
+static void XVidC_ModeHashBuild(void)
+{
+	int Index;
+
+	memset(XVidC_ModeHashHead, 0xFF, sizeof(XVidC_ModeHashHead));
+	XVidC_ModeHashNumNodes = 0;
+
+	for (Index = XVIDC_VM_NUM_SUPPORTED - 1; Index >= 0; Index--) {
+		XVidC_ModeHashInsert(&XVidC_VideoTimingModes[Index]);
+	}
+	for (Index = XVidC_NumCustomModes - 1; Index >= 0; Index--) {
+		XVidC_ModeHashInsert(&XVidC_CustomTimingModes[Index]);
+	}
+
+	XVidC_ModeHashReady = TRUE;
+}
+
+/******************************************************************************/
+/**
+ * This function looks up a video mode in the video mode hash index.
+ *
+ * @param	Key is the video mode key to look up.
+ * @param	Mask selects the key bits that have to match.
+ * @param	Timing is the timing the video mode has to match, or NULL to
+ *		match on the key only.
+ * @param	IsInterlaced specifies whether field 1 of Timing is matched.
+ *
+ * @return	ID of the first matching video mode, or XVIDC_VM_NOT_SUPPORTED.
+ *
+ * @note	The index over the built-in table is built on the first lookup,
+ *		under the same lock as the rebuilds on registration.
+ *
+*******************************************************************************/
+static XVidC_VideoMode XVidC_ModeHashLookup(u64 Key, u64 Mask,
+		const XVidC_VideoTiming *Timing, u8 IsInterlaced)
+{
+	XVidC_VideoMode VmId;
+
+	mutex_lock(&XVidC_ModeLock);
+	if (!XVidC_ModeHashReady) {
+		XVidC_ModeHashBuild();
+	}
+	VmId = XVidC_ModeHashFind(Key, Mask, Timing, IsInterlaced);
+	mutex_unlock(&XVidC_ModeLock);
+
+	return VmId;
+}
+
+/******************************************************************************/
+/**
+ * This function walks the video mode hash index chain of a key.
+ *
+ * @param	Key is the video mode key to look up.
+ * @param	Mask selects the key bits that have to match.
+ * @param	Timing is the timing the video mode has to match, or NULL to
+ *		match on the key only.
+ * @param	IsInterlaced specifies whether field 1 of Timing is matched.
+ *
+ * @return	ID of the first matching video mode, or XVIDC_VM_NOT_SUPPORTED.
+ *
+ * @note	Must be called with XVidC_ModeLock held and the index built.
+ *
+*******************************************************************************/
+static XVidC_VideoMode XVidC_ModeHashFind(u64 Key, u64 Mask,
+		const XVidC_VideoTiming *Timing, u8 IsInterlaced)
+{
+	u64 Sig[XVIDC_MODE_SIG_WORDS];
+	const u64 *NodeSig;
+	u64 Diff;
+	u16 Node;
+
+	if (Timing) {
+		XVidC_ModeSig(Timing, Sig);
+	}
+
+	for (Node = XVidC_ModeHashHead[XVidC_ModeHash(Key)];
+			Node != XVIDC_MODE_HASH_NONE;
+			Node = XVidC_ModeHashNext[Node]) {
+		if ((XVidC_ModeHashKey[Node] ^ Key) & Mask) {
+			continue;
+		}
+		if (Timing) {
+			NodeSig = XVidC_ModeHashSig[Node];
+			Diff = (NodeSig[0] ^ Sig[0]) | (NodeSig[1] ^ Sig[1]);
+			if (IsInterlaced) {
+				Diff |= NodeSig[2] ^ Sig[2];
+			}
+			if (Diff) {
+				continue;
+			}
+		}
+		return XVidC_ModeHashVm[Node]->VmId;
+	}
+
+	return XVIDC_VM_NOT_SUPPORTED;
+}
+
+/******************************************************************************/
+/**
+ * This function packs the blanking fields checked by the extensive video mode
+ * match into a signature, so that a timing is matched with a few word
+ * compares.
+ *
+ * @param	Timing is a pointer to the timing.
+ * @param	Sig is the signature to fill in:
+ *		- Sig[0]: HTotal, F0PVTotal, HFrontPorch, F0PVFrontPorch
+ *		- Sig[1]: HSyncWidth, F0PVSyncWidth, VSyncPolarity
+ *		- Sig[2]: F1VTotal, F1VFrontPorch, F1VSyncWidth (interlaced only)
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XVidC_ModeSig(const XVidC_VideoTiming *Timing,
+		u64 Sig[XVIDC_MODE_SIG_WORDS])
+{
+	Sig[0] = ((u64)Timing->HTotal << 48) | ((u64)Timing->F0PVTotal << 32) |
+		((u64)Timing->HFrontPorch << 16) | Timing->F0PVFrontPorch;
+	Sig[1] = ((u64)Timing->HSyncWidth << 48) |
+		((u64)Timing->F0PVSyncWidth << 32) |
+		((u64)Timing->VSyncPolarity << 16);
+	Sig[2] = ((u64)Timing->F1VTotal << 32) |
+		((u64)Timing->F1VFrontPorch << 16) | Timing->F1VSyncWidth;
 }
 
 /******************************************************************************/
@@ -1197,6 +1691,7 @@ static u8 XVidC_IsVtmRb(const char *VideoModeStr, u8 RbN)
 int XVidC_ShowStreamInfo(const XVidC_VideoStream *Stream, char *buff, int buff_size)
 {
 	int strSize = 0;
+	u32 FrameRateMilliHz;
 
 	strSize = scnprintf(buff+strSize, buff_size-strSize,
 				"\r\n  Stream Info\r\n" \
@@ -1228,18 +1723,20 @@ int XVidC_ShowStreamInfo(const XVidC_VideoStream *Stream, char *buff, int buff_s
 	}
 
 	if (Stream->VmId == XVIDC_VM_CUSTOM) {
+		FrameRateMilliHz = Stream->FrameRateMilliHz ?
+			Stream->FrameRateMilliHz :
+			XVIDC_FR_MILLIHZ(Stream->FrameRate);
 		strSize += scnprintf(buff+strSize, buff_size-strSize,
-				"\tFrame Rate:       %dHz\r\n",
-				Stream->FrameRate);
+				"\tFrame Rate:       %u.%03uHz\r\n",
+				FrameRateMilliHz / 1000,
+				FrameRateMilliHz % 1000);
 		strSize += scnprintf(buff+strSize, buff_size-strSize,
 				"\tResolution:       %dx%d [Custom Mode]\r\n",
 				Stream->Timing.HActive, Stream->Timing.VActive);
 		strSize += scnprintf(buff+strSize, buff_size-strSize,
-				"\tPixel Clock:      %d\r\n",
-				XVidC_GetPixelClockHzByHVFr(
-					Stream->Timing.HTotal,
-					Stream->Timing.F0PVTotal,
-					Stream->FrameRate));
+				"\tPixel Clock:      %llu\r\n",
+				(XVidC_GetPixelClockMilliHzByStream(Stream) +
+				 500) / 1000);
 	}
 	else {
 		strSize += scnprintf(buff+strSize, buff_size-strSize,
@@ -1249,7 +1746,7 @@ int XVidC_ShowStreamInfo(const XVidC_VideoStream *Stream, char *buff, int buff_s
 				"\tResolution:       %s\r\n",
 				XVidC_GetVideoModeStr(Stream->VmId));
 		strSize += scnprintf(buff+strSize, buff_size-strSize,
-				"\tPixel Clock:      %d\r\n",
+				"\tPixel Clock:      %llu\r\n",
 				XVidC_GetPixelClockHzByVmId(Stream->VmId));
 	}
 
@@ -66,6 +66,28 @@ extern "C" {
 
 /************************** Constant Definitions ******************************/
 
+/**
+ * Maximum number of modes in a custom video timing table.
+ */
+#define XVIDC_MAX_CUSTOM_MODES	512
+
+/**
+ * Video timing mode attribute flags.
+ */
+#define XVIDC_VM_FLAG_RB_MASK		0x03	/**< Reduced blanking class. */
+#define XVIDC_VM_FLAG_RB		0x01	/**< Reduced blanking (CVT-RB). */
+#define XVIDC_VM_FLAG_RB2		0x02	/**< Reduced blanking v2. */
+#define XVIDC_VM_FLAG_INTERLACED	0x04	/**< Interlaced mode. */
+#define XVIDC_VM_FLAG_3D		0x08	/**< Mandatory HDMI 1.4 3D
+						  *  format. */
+
+/**
+ * Frame rate in millihertz of an integer rate, and of its NTSC counterpart
+ * that runs 1000/1001 slower (e.g. 59.94 Hz for 60 Hz).
+ */
+#define XVIDC_FR_MILLIHZ(Fr)		((u32)(Fr) * 1000)
+#define XVIDC_FR_MILLIHZ_1001(Fr)	(((u32)(Fr) * 1000000 + 500) / 1001)
+
 /**
  * This typedef enumerates the list of available standard display monitor
  * timings as specified in the xvidc_timings_table.c file. The naming format is:
@@ -483,13 +505,15 @@ typedef struct {
 } XVidC_3DInfo;
 
 /**
- * Video stream structure.
+ * Video stream structure. FrameRateMilliHz is the exact frame rate; 0 means
+ * exactly FrameRate.
  */
 typedef struct {
 	XVidC_ColorFormat	  ColorFormatId;
 	XVidC_ColorDepth	  ColorDepth;
 	XVidC_PixelsPerClock  PixPerClk;
 	XVidC_FrameRate		  FrameRate;
+	u32			          FrameRateMilliHz;
 	XVidC_AspectRatio	  AspectRatio;
 	u8			          IsInterlaced;
 	u8			          Is3D;
@@ -509,13 +533,16 @@ typedef struct {
 } XVidC_VideoWindow;
 
 /**
- * Video timing mode from the video timing table.
+ * Video timing mode from the video timing table. FrameRateMilliHz is the exact
+ * frame rate of a fractional mode; 0 means exactly FrameRate.
  */
 typedef struct {
 	XVidC_VideoMode		VmId;
 	const char		    Name[21];
 	XVidC_FrameRate		FrameRate;
 	XVidC_VideoTiming	Timing;
+	u8			Flags;
+	u32			FrameRateMilliHz;
 } XVidC_VideoTimingMode;
 
 /**
@@ -537,8 +564,14 @@ typedef void (*XVidC_DelayHandler)(void *TimerPtr, u32 Delay);
 u32 XVidC_RegisterCustomTimingModes(const XVidC_VideoTimingMode *CustomTable,
 		                            u16 NumElems);
 void XVidC_UnregisterCustomTimingModes(void);
-u32 XVidC_GetPixelClockHzByHVFr(u32 HTotal, u32 VTotal, u8 FrameRate);
-u32 XVidC_GetPixelClockHzByVmId(XVidC_VideoMode VmId);
+u32 XVidC_AddCustomTimingMode(const XVidC_VideoTimingMode *VmPtr);
+u32 XVidC_RemoveCustomTimingMode(XVidC_VideoMode VmId);
+u64 XVidC_GetPixelClockHzByHVFr(u32 HTotal, u32 VTotal, u8 FrameRate);
+u64 XVidC_GetPixelClockHzByVmId(XVidC_VideoMode VmId);
+u64 XVidC_GetPixelClockMilliHzByHVFr(u32 HTotal, u32 VTotal,
+		u32 FrameRateMilliHz);
+u64 XVidC_GetPixelClockMilliHzByVmId(XVidC_VideoMode VmId);
+u64 XVidC_GetPixelClockMilliHzByStream(const XVidC_VideoStream *Stream);
 XVidC_VideoFormat XVidC_GetVideoFormat(XVidC_VideoMode VmId);
 u8 XVidC_IsInterlaced(XVidC_VideoMode VmId);
 const XVidC_VideoTimingMode* XVidC_GetVideoModeData(XVidC_VideoMode VmId);
@@ -546,6 +579,7 @@ const char *XVidC_GetVideoModeStr(XVidC_VideoMode VmId);
 const char *XVidC_GetFrameRateStr(XVidC_VideoMode VmId);
 const char *XVidC_GetColorFormatStr(XVidC_ColorFormat ColorFormatId);
 XVidC_FrameRate XVidC_GetFrameRate(XVidC_VideoMode VmId);
+u32 XVidC_GetFrameRateMilliHz(XVidC_VideoMode VmId);
 const XVidC_VideoTiming* XVidC_GetTimingInfo(XVidC_VideoMode VmId);
 void XVidC_ReportStreamInfo(const XVidC_VideoStream *Stream);
 void XVidC_ReportTiming(const XVidC_VideoTiming *Timing, u8 IsInterlaced);
@@ -567,6 +601,10 @@ XVidC_VideoMode XVidC_GetVideoModeIdRb(u32 Width, u32 Height, u32 FrameRate,
 XVidC_VideoMode XVidC_GetVideoModeIdWBlanking(const XVidC_VideoTiming *Timing,
 		                                      u32 FrameRate, u8 IsInterlaced);
 
+u16 XVidC_GetNumVideoModes(void);
+const XVidC_VideoTimingMode *XVidC_GetVideoModeDataByIndex(u16 Index);
+int XVidC_GetVideoModeIndex(XVidC_VideoMode VmId);
+
 int XVidC_ShowStreamInfo(const XVidC_VideoStream *Stream, char *buff, int buff_size);
 
 /******************* Macros (Inline Functions) Definitions ********************/
@@ -585,6 +623,36 @@ int XVidC_ShowStreamInfo(const XVidC_VideoStream *Stream, char *buff, int buff_s
  *****************************************************************************/
 #define XVidC_IsStream3D(VidStreamPtr)       ((VidStreamPtr)->Is3D)
 
+/*****************************************************************************/
+/**
+ * This macro returns the reduced blanking class of a video timing mode.
+ *
+ * @param	VtmPtr is a pointer to the XVidC_VideoTimingMode structure.
+ *
+ * @return	0 = No reduced blanking, 1 = RB, 2 = RB2.
+ *
+ * @note	C-style signature:
+ *		u8 XVidC_GetVtmRbClass(const XVidC_VideoTimingMode *VtmPtr)
+ *
+ *****************************************************************************/
+#define XVidC_GetVtmRbClass(VtmPtr) \
+	((VtmPtr)->Flags & XVIDC_VM_FLAG_RB_MASK)
+
+/*****************************************************************************/
+/**
+ * This macro checks if a video timing mode is a mandatory 3D format.
+ *
+ * @param	VtmPtr is a pointer to the XVidC_VideoTimingMode structure.
+ *
+ * @return	3D capable(1)/not(0)
+ *
+ * @note	C-style signature:
+ *		u8 XVidC_IsVtm3D(const XVidC_VideoTimingMode *VtmPtr)
+ *
+ *****************************************************************************/
+#define XVidC_IsVtm3D(VtmPtr) \
+	(((VtmPtr)->Flags & XVIDC_VM_FLAG_3D) ? 1 : 0)
+
 /*************************** Variable Declarations ****************************/
 
 #ifdef __cplusplus
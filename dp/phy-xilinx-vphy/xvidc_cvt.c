@@ -0,0 +1,389 @@
+/*******************************************************************************
+* Copyright (C) 2015 - 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: GPL-2.0
+*******************************************************************************/
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_cvt.c
+ * @addtogroup video_common_v4_0
+ * @{
+ *
+ * Contains the VESA Coordinated Video Timings (CVT 1.2) generator. It computes
+ * progressive timings with standard CRT blanking, reduced blanking (CVT-RB) and
+ * reduced blanking v2 (CVT-RB2) for video modes that are not part of the video
+ * timing table, and caches them apart from the registered custom video modes.
+ *
+ * @note	All arithmetic is done in integers: times are kept in
+ *		picoseconds and the duty cycle in millionths of a percent.
+ *
+*******************************************************************************/
+
+/******************************* Include Files ********************************/
+
+#include <linux/kernel.h>
+#include <linux/mutex.h>
+#include <linux/string.h>
+#include "xil_assert.h"
+#include "xstatus.h"
+#include "xvidc_cvt.h"
+
+/************************** Constant Definitions ******************************/
+
+#define XVIDC_CVT_PS_PER_SEC		1000000000000ULL
+
+/* Standard CRT blanking. */
+#define XVIDC_CVT_CELL_GRAN		8
+#define XVIDC_CVT_MIN_V_PORCH		3
+#define XVIDC_CVT_MIN_V_BPORCH		6
+#define XVIDC_CVT_MIN_VSYNC_BP_PS	550000000ULL
+/* C' = 30% and M' = 300%/kHz of the blanking formula, and the minimum duty
+ * cycle of 20%, in millionths of a percent. */
+#define XVIDC_CVT_C_PRIME_UPCT		30000000LL
+#define XVIDC_CVT_MIN_DUTY_UPCT		20000000LL
+#define XVIDC_CVT_HUNDRED_UPCT		100000000LL
+#define XVIDC_CVT_H_SYNC_PER		8
+#define XVIDC_CVT_CLOCK_STEP_HZ		250000
+
+/* Reduced blanking. */
+#define XVIDC_CVT_RB_MIN_V_BLANK_PS	460000000ULL
+#define XVIDC_CVT_RB_H_BLANK		160
+#define XVIDC_CVT_RB_H_SYNC		32
+#define XVIDC_CVT_RB_H_FPORCH		48
+#define XVIDC_CVT_RB_V_FPORCH		3
+
+/* Reduced blanking v2. */
+#define XVIDC_CVT_RB2_H_BLANK		80
+#define XVIDC_CVT_RB2_H_SYNC		32
+#define XVIDC_CVT_RB2_H_FPORCH		8
+#define XVIDC_CVT_RB2_V_SYNC		8
+#define XVIDC_CVT_RB2_V_FPORCH		1
+#define XVIDC_CVT_RB2_CLOCK_STEP_HZ	1000
+
+/* Generated modes kept, they get IDs XVIDC_VM_CVT_FIRST + position. */
+#define XVIDC_CVT_MAX_MODES		32
+
+/*************************** Variable Declarations ****************************/
+
+/* Generated video modes, only ever appended to so that the timing data of
+ * an ID handed out stays put. */
+static XVidC_VideoTimingMode XVidC_CvtModes[XVIDC_CVT_MAX_MODES];
+static u16 XVidC_CvtNumModes;
+static DEFINE_MUTEX(XVidC_CvtLock);
+
+/**************************** Function Prototypes *****************************/
+
+static u8 XVidC_CvtGetVSync(u16 HActive, u16 VActive);
+
+/**************************** Function Definitions ****************************/
+
+/******************************************************************************/
+/**
+ * This function generates the CVT timing of a progressive video mode.
+ *
+ * @param	HActive is the number of active pixels per line. Standard and
+ *		RB timings round it down to a multiple of 8.
+ * @param	VActive is the number of active lines.
+ * @param	FrameRate is the requested frame rate in Hz.
+ * @param	Type selects the CVT blanking formula.
+ * @param	Timing is filled with the generated timing.
+ * @param	PixelClkHzPtr is set to the pixel clock of the timing, which
+ *		CVT quantizes to 0.25 MHz (1 kHz for RB2), or may be NULL.
+ *
+ * @return
+ *		- XST_SUCCESS if the timing was generated.
+ *		- XST_FAILURE if the arguments are out of range or a total
+ *		  does not fit the timing structure.
+ *
+ * @note	Interlaced timings and margins are not generated.
+ *
+*******************************************************************************/
+u32 XVidC_CvtGenerateTiming(u16 HActive, u16 VActive, u8 FrameRate,
+		XVidC_CvtType Type, XVidC_VideoTiming *Timing,
+		u64 *PixelClkHzPtr)
+{
+	u64 FramePs;
+	u64 HPeriodPs;
+	u64 PixelClkHz;
+	s64 DutyUpct;
+	u32 HBlank;
+	u32 HSync;
+	u32 HFrontPorch;
+	u32 HTotal;
+	u32 VSync;
+	u32 VFrontPorch;
+	u32 VBlank;
+	u32 VTotal;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Timing != NULL);
+	Xil_AssertNonvoid(Type <= XVIDC_CVT_RB2);
+
+	if (Type != XVIDC_CVT_RB2) {
+		HActive -= HActive % XVIDC_CVT_CELL_GRAN;
+	}
+	if ((HActive == 0) || (VActive == 0) || (FrameRate == 0)) {
+		return XST_FAILURE;
+	}
+
+	FramePs = XVIDC_CVT_PS_PER_SEC / FrameRate;
+
+	if (Type == XVIDC_CVT_STANDARD) {
+		if (FramePs <= XVIDC_CVT_MIN_VSYNC_BP_PS) {
+			return XST_FAILURE;
+		}
+		HPeriodPs = (FramePs - XVIDC_CVT_MIN_VSYNC_BP_PS) /
+			(VActive + XVIDC_CVT_MIN_V_PORCH);
+
+		/* Vertical sync and back porch take at least 550 us. */
+		VSync = XVidC_CvtGetVSync(HActive, VActive);
+		VBlank = XVIDC_CVT_MIN_VSYNC_BP_PS / HPeriodPs + 1;
+		if (VBlank < VSync + XVIDC_CVT_MIN_V_BPORCH) {
+			VBlank = VSync + XVIDC_CVT_MIN_V_BPORCH;
+		}
+		VFrontPorch = XVIDC_CVT_MIN_V_PORCH;
+		VBlank += VFrontPorch;
+
+		/* The horizontal blanking follows the ideal duty cycle
+		 * C' - M' * HPeriod, in whole character cell pairs. */
+		DutyUpct = XVIDC_CVT_C_PRIME_UPCT - (s64)(HPeriodPs * 3 / 10);
+		if (DutyUpct < XVIDC_CVT_MIN_DUTY_UPCT) {
+			DutyUpct = XVIDC_CVT_MIN_DUTY_UPCT;
+		}
+		HBlank = (u64)HActive * DutyUpct /
+			((XVIDC_CVT_HUNDRED_UPCT - DutyUpct) *
+			 2 * XVIDC_CVT_CELL_GRAN);
+		HBlank *= 2 * XVIDC_CVT_CELL_GRAN;
+		HTotal = HActive + HBlank;
+
+		HSync = HTotal * XVIDC_CVT_H_SYNC_PER / 100;
+		HSync -= HSync % XVIDC_CVT_CELL_GRAN;
+		HFrontPorch = HBlank / 2 - HSync;
+
+		PixelClkHz = (u64)HTotal * XVIDC_CVT_PS_PER_SEC / HPeriodPs;
+		PixelClkHz -= PixelClkHz % XVIDC_CVT_CLOCK_STEP_HZ;
+	}
+	else {
+		if (FramePs <= XVIDC_CVT_RB_MIN_V_BLANK_PS) {
+			return XST_FAILURE;
+		}
+		HPeriodPs = (FramePs - XVIDC_CVT_RB_MIN_V_BLANK_PS) / VActive;
+
+		if (Type == XVIDC_CVT_RB) {
+			VSync = XVidC_CvtGetVSync(HActive, VActive);
+			VFrontPorch = XVIDC_CVT_RB_V_FPORCH;
+			HBlank = XVIDC_CVT_RB_H_BLANK;
+			HSync = XVIDC_CVT_RB_H_SYNC;
+			HFrontPorch = XVIDC_CVT_RB_H_FPORCH;
+		}
+		else {
+			VSync = XVIDC_CVT_RB2_V_SYNC;
+			VFrontPorch = XVIDC_CVT_RB2_V_FPORCH;
+			HBlank = XVIDC_CVT_RB2_H_BLANK;
+			HSync = XVIDC_CVT_RB2_H_SYNC;
+			HFrontPorch = XVIDC_CVT_RB2_H_FPORCH;
+		}
+
+		/* The vertical blanking takes at least 460 us. */
+		VBlank = XVIDC_CVT_RB_MIN_V_BLANK_PS / HPeriodPs + 1;
+		if (VBlank < VFrontPorch + VSync + XVIDC_CVT_MIN_V_BPORCH) {
+			VBlank = VFrontPorch + VSync + XVIDC_CVT_MIN_V_BPORCH;
+		}
+		/* RB2 keeps the back porch and stretches the front porch. */
+		if (Type == XVIDC_CVT_RB2) {
+			VFrontPorch = VBlank - VSync - XVIDC_CVT_MIN_V_BPORCH;
+		}
+		HTotal = HActive + HBlank;
+
+		PixelClkHz = (u64)FrameRate * (VActive + VBlank) * HTotal;
+		PixelClkHz -= PixelClkHz % ((Type == XVIDC_CVT_RB) ?
+				XVIDC_CVT_CLOCK_STEP_HZ :
+				XVIDC_CVT_RB2_CLOCK_STEP_HZ);
+	}
+
+	VTotal = VActive + VBlank;
+	if ((HTotal > 0xFFFF) || (VTotal > 0xFFFF)) {
+		return XST_FAILURE;
+	}
+
+	memset(Timing, 0, sizeof(XVidC_VideoTiming));
+	Timing->HActive = HActive;
+	Timing->HFrontPorch = HFrontPorch;
+	Timing->HSyncWidth = HSync;
+	Timing->HBackPorch = HBlank - HFrontPorch - HSync;
+	Timing->HTotal = HTotal;
+	Timing->VActive = VActive;
+	Timing->F0PVFrontPorch = VFrontPorch;
+	Timing->F0PVSyncWidth = VSync;
+	Timing->F0PVBackPorch = VBlank - VFrontPorch - VSync;
+	Timing->F0PVTotal = VTotal;
+	/* CRT blanking uses -hsync +vsync, reduced blanking +hsync -vsync. */
+	Timing->HSyncPolarity = (Type == XVIDC_CVT_STANDARD) ? 0 : 1;
+	Timing->VSyncPolarity = (Type == XVIDC_CVT_STANDARD) ? 1 : 0;
+
+	if (PixelClkHzPtr) {
+		*PixelClkHzPtr = PixelClkHz;
+	}
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the ID of a progressive video mode, generating its CVT
+ * timing when the mode is unknown.
+ *
+ * The video timing table and the registered custom modes are searched first,
+ * for the active size, frame rate and reduced blanking class, then the modes
+ * generated before. If none matches, the CVT timing is generated and kept,
+ * so later calls for the same mode return the same ID.
+ *
+ * @param	HActive is the number of active pixels per line.
+ * @param	VActive is the number of active lines.
+ * @param	FrameRate is the frame rate in Hz.
+ * @param	Type selects the CVT blanking formula.
+ *
+ * @return	ID of the video mode, or XVIDC_VM_NOT_SUPPORTED if no timing
+ *		could be generated or XVIDC_CVT_MAX_MODES modes are kept.
+ *
+ * @note	Generated modes get IDs from XVIDC_VM_CVT_FIRST on and are
+ *		returned by XVidC_GetVideoModeData(), but are not part of the
+ *		custom video modes. Their FrameRateMilliHz holds the exact frame
+ *		rate of the quantized pixel clock.
+ *
+*******************************************************************************/
+XVidC_VideoMode XVidC_CvtGetVideoModeId(u16 HActive, u16 VActive,
+		u8 FrameRate, XVidC_CvtType Type)
+{
+	XVidC_VideoTimingMode *VmPtr;
+	XVidC_VideoMode VmId;
+	u64 PixelClkHz;
+	u64 PixelsPerFrame;
+	u8 Flags;
+	u16 Index;
+
+	VmId = XVidC_GetVideoModeIdRb(HActive, VActive, FrameRate, FALSE, Type);
+	if (VmId != XVIDC_VM_NOT_SUPPORTED) {
+		return VmId;
+	}
+
+	/* Generated modes are kept by the active width CVT rounds to. */
+	if (Type != XVIDC_CVT_RB2) {
+		HActive -= HActive % XVIDC_CVT_CELL_GRAN;
+	}
+	Flags = (Type == XVIDC_CVT_RB2) ? XVIDC_VM_FLAG_RB2 :
+		(Type == XVIDC_CVT_RB) ? XVIDC_VM_FLAG_RB : 0;
+
+	mutex_lock(&XVidC_CvtLock);
+
+	for (Index = 0; Index < XVidC_CvtNumModes; Index++) {
+		VmPtr = &XVidC_CvtModes[Index];
+		if ((VmPtr->Timing.HActive == HActive) &&
+				(VmPtr->Timing.VActive == VActive) &&
+				(VmPtr->FrameRate == FrameRate) &&
+				(VmPtr->Flags == Flags)) {
+			mutex_unlock(&XVidC_CvtLock);
+			return VmPtr->VmId;
+		}
+	}
+
+	if (XVidC_CvtNumModes == XVIDC_CVT_MAX_MODES) {
+		mutex_unlock(&XVidC_CvtLock);
+		return XVIDC_VM_NOT_SUPPORTED;
+	}
+
+	VmPtr = &XVidC_CvtModes[XVidC_CvtNumModes];
+	memset(VmPtr, 0, sizeof(*VmPtr));
+	if (XVidC_CvtGenerateTiming(HActive, VActive, FrameRate, Type,
+			&VmPtr->Timing, &PixelClkHz) != XST_SUCCESS) {
+		mutex_unlock(&XVidC_CvtLock);
+		return XVIDC_VM_NOT_SUPPORTED;
+	}
+
+	PixelsPerFrame = (u64)VmPtr->Timing.HTotal * VmPtr->Timing.F0PVTotal;
+	VmPtr->VmId = XVIDC_VM_CVT_FIRST + XVidC_CvtNumModes;
+	scnprintf((char *)VmPtr->Name, sizeof(VmPtr->Name), "%dx%d@%dHz%s",
+			HActive, VActive, FrameRate,
+			(Type == XVIDC_CVT_RB2) ? " RB2" :
+			(Type == XVIDC_CVT_RB) ? " RB" : "");
+	VmPtr->FrameRate = FrameRate;
+	VmPtr->Flags = Flags;
+	VmPtr->FrameRateMilliHz = (PixelClkHz * 1000 + PixelsPerFrame / 2) /
+		PixelsPerFrame;
+	XVidC_CvtNumModes++;
+
+	mutex_unlock(&XVidC_CvtLock);
+
+	return VmPtr->VmId;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the data of a video mode generated by
+ * XVidC_CvtGetVideoModeId().
+ *
+ * @param	VmId specifies the resolution ID.
+ *
+ * @return	Pointer to XVidC_VideoTimingMode structure, or NULL if no mode
+ *		was generated with that ID.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+const XVidC_VideoTimingMode *XVidC_CvtGetVideoModeData(XVidC_VideoMode VmId)
+{
+	const XVidC_VideoTimingMode *VmPtr = NULL;
+
+	if (VmId < XVIDC_VM_CVT_FIRST) {
+		return NULL;
+	}
+
+	mutex_lock(&XVidC_CvtLock);
+	if (VmId - XVIDC_VM_CVT_FIRST < XVidC_CvtNumModes) {
+		VmPtr = &XVidC_CvtModes[VmId - XVIDC_VM_CVT_FIRST];
+	}
+	mutex_unlock(&XVidC_CvtLock);
+
+	return VmPtr;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the CVT vertical sync width, which encodes the aspect
+ * ratio of standard and reduced blanking timings.
+ *
+ * @param	HActive is the number of active pixels per line, a multiple of
+ *		the character cell.
+ * @param	VActive is the number of active lines.
+ *
+ * @return	The vertical sync width in lines.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u8 XVidC_CvtGetVSync(u16 HActive, u16 VActive)
+{
+	static const struct {
+		u8 Num;
+		u8 Den;
+		u8 VSync;
+	} AspectRatios[] = {
+		{ 4, 3, 4 }, { 16, 9, 5 }, { 16, 10, 6 }, { 5, 4, 7 },
+		{ 15, 9, 7 },
+	};
+	u32 Width;
+	u8 Index;
+
+	for (Index = 0; Index < ARRAY_SIZE(AspectRatios); Index++) {
+		Width = (u32)VActive * AspectRatios[Index].Num /
+			AspectRatios[Index].Den;
+		Width -= Width % XVIDC_CVT_CELL_GRAN;
+		if (Width == HActive) {
+			return AspectRatios[Index].VSync;
+		}
+	}
+
+	/* Non-standard aspect ratio. */
+	return 10;
+}
+/** @} */
@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright (C) 2015 - 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: GPL-2.0
+*******************************************************************************/
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_cvt.h
+ * @addtogroup video_common_v4_0
+ * @{
+ *
+ * Contains definitions and function declarations of the VESA Coordinated Video
+ * Timings (CVT) generator, which computes the timing of video modes that are
+ * not part of the video timing table.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+
+#ifndef XVIDC_CVT_H_
+/* Prevent circular inclusions by using protection macros. */
+#define XVIDC_CVT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************* Include Files ********************************/
+
+#include "xil_types.h"
+#include "xvidc.h"
+
+/************************** Constant Definitions ******************************/
+
+/**
+ * First video mode ID handed out to generated CVT modes. User defined custom
+ * timing tables have to use IDs below this one.
+ */
+#define XVIDC_VM_CVT_FIRST	(XVIDC_VM_CUSTOM + 0x8000)
+
+/****************************** Type Definitions ******************************/
+
+/**
+ * This typedef enumerates the CVT blanking formulas. The values match the
+ * reduced blanking class of XVidC_GetVideoModeIdRb().
+ */
+typedef enum {
+	XVIDC_CVT_STANDARD = 0,	/**< CVT with standard CRT blanking. */
+	XVIDC_CVT_RB,		/**< CVT reduced blanking. */
+	XVIDC_CVT_RB2,		/**< CVT reduced blanking v2. */
+} XVidC_CvtType;
+
+/**************************** Function Prototypes *****************************/
+
+u32 XVidC_CvtGenerateTiming(u16 HActive, u16 VActive, u8 FrameRate,
+		XVidC_CvtType Type, XVidC_VideoTiming *Timing,
+		u64 *PixelClkHzPtr);
+XVidC_VideoMode XVidC_CvtGetVideoModeId(u16 HActive, u16 VActive,
+		u8 FrameRate, XVidC_CvtType Type);
+const XVidC_VideoTimingMode *XVidC_CvtGetVideoModeData(XVidC_VideoMode VmId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XVIDC_CVT_H_ */
+/** @} */
@@ -31,19 +31,168 @@
 
 /******************************* Include Files ********************************/
 
+#include <linux/bits.h>
+#include <linux/kernel.h>
+#include <linux/math64.h>
+#include <linux/string.h>
+#include "xil_assert.h"
 #include "xvidc_edid.h"
 
 /**************************** Function Prototypes *****************************/
 
-static u32 XVidC_EdidIsVideoTimingSupportedPreferredTiming(const u8 *EdidRaw,
-		const XVidC_VideoTimingMode *VtMode);
-static u32 XVidC_EdidIsVideoTimingSupportedEstablishedTimings(const u8 *EdidRaw,
-		const XVidC_VideoTimingMode *VtMode);
-static u32 XVidC_EdidIsVideoTimingSupportedStandardTimings(const u8 *EdidRaw,
+static void XVidC_EdidDecodeTimings(const u8 *EdidRaw, XVidC_EdidCaps *Caps);
+static void XVidC_EdidAddTiming(XVidC_EdidCaps *Caps, u16 HActive,
+		u16 VActive, u8 FrameRate, u8 IsInterlaced);
+static u8 XVidC_EdidCapsIsTimingAdvertised(const XVidC_EdidCaps *Caps,
+		u8 FirstTiming, u8 LastTiming,
 		const XVidC_VideoTimingMode *VtMode);
+static void XVidC_EdidCapsMarkModes(XVidC_EdidCaps *Caps, u8 FirstTiming);
+static void XVidC_EdidCapsMarkVic(XVidC_EdidCaps *Caps, u8 Vic, u8 Y420Only);
+static u32 XVidC_EdidGetFrameRate(u32 ClkKhz, u32 HTotal, u32 VTotal,
+		u8 *FrameRate);
+static void XVidC_EdidDecodeDtd(XVidC_EdidCaps *Caps, const u8 *Dtd,
+		u8 AnyRate);
+static void XVidC_EdidParseCea(XVidC_EdidCaps *Caps, const u8 *ExtRaw);
+static void XVidC_EdidParseCeaHdmiVsdb(XVidC_EdidCaps *Caps, const u8 *Db,
+		u8 Len);
+static void XVidC_EdidParseDisplayId(XVidC_EdidCaps *Caps, const u8 *ExtRaw);
 static int XVidC_CalculatePower(u8 Base, u8 Power);
 static int XVidC_CalculateBinaryFraction_QFormat(u16 Val, u8 DecPtIndex);
 
+/**************************** Variable Definitions ****************************/
+
+/**
+ * Established timings I, II and the manufacturer's timings byte, as bit masks
+ * of the three bytes starting at XVIDC_EDID_EST_TIMINGS_I.
+ */
+static const struct {
+	u8 Offset;
+	u8 Mask;
+	u16 HActive;
+	u16 VActive;
+	u8 FrameRate;
+} XVidC_EdidEstTimings[] = {
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_720x400_70_MASK,
+		720, 400, XVIDC_FR_70HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_720x400_88_MASK,
+		720, 400, XVIDC_FR_88HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_640x480_60_MASK,
+		640, 480, XVIDC_FR_60HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_640x480_67_MASK,
+		640, 480, XVIDC_FR_67HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_640x480_72_MASK,
+		640, 480, XVIDC_FR_72HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_640x480_75_MASK,
+		640, 480, XVIDC_FR_75HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_800x600_56_MASK,
+		800, 600, XVIDC_FR_56HZ},
+	{XVIDC_EDID_EST_TIMINGS_I, XVIDC_EDID_EST_TIMINGS_I_800x600_60_MASK,
+		800, 600, XVIDC_FR_60HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_800x600_72_MASK,
+		800, 600, XVIDC_FR_72HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_800x600_75_MASK,
+		800, 600, XVIDC_FR_75HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_832x624_75_MASK,
+		832, 624, XVIDC_FR_75HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_1024x768_87_MASK,
+		1024, 768, XVIDC_FR_87HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_1024x768_60_MASK,
+		1024, 768, XVIDC_FR_60HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_1024x768_70_MASK,
+		1024, 768, XVIDC_FR_70HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_1024x768_75_MASK,
+		1024, 768, XVIDC_FR_75HZ},
+	{XVIDC_EDID_EST_TIMINGS_II, XVIDC_EDID_EST_TIMINGS_II_1280x1024_75_MASK,
+		1280, 1024, XVIDC_FR_75HZ},
+	{XVIDC_EDID_EST_TIMINGS_MAN, XVIDC_EDID_EST_TIMINGS_MAN_1152x870_75_MASK,
+		1152, 870, XVIDC_FR_75HZ},
+};
+
+/**
+ * CEA-861 video identification codes (VICs) of the modes in the video timing
+ * table. Aspect ratio variants of a timing map to the same mode.
+ */
+static const struct {
+	u8 Vic;
+	XVidC_VideoMode VmId;
+} XVidC_EdidCeaVics[] = {
+	{1, XVIDC_VM_640x480_60_P},
+	{2, XVIDC_VM_720x480_60_P},
+	{3, XVIDC_VM_720x480_60_P},
+	{4, XVIDC_VM_1280x720_60_P},
+	{5, XVIDC_VM_1920x1080_60_I},
+	{6, XVIDC_VM_1440x480_60_I},
+	{7, XVIDC_VM_1440x480_60_I},
+	{8, XVIDC_VM_1440x240_60_P},
+	{9, XVIDC_VM_1440x240_60_P},
+	{16, XVIDC_VM_1920x1080_60_P},
+	{17, XVIDC_VM_720x576_50_P},
+	{18, XVIDC_VM_720x576_50_P},
+	{19, XVIDC_VM_1280x720_50_P},
+	{20, XVIDC_VM_1920x1080_50_I},
+	{21, XVIDC_VM_1440x576_50_I},
+	{22, XVIDC_VM_1440x576_50_I},
+	{31, XVIDC_VM_1920x1080_50_P},
+	{32, XVIDC_VM_1920x1080_24_P},
+	{33, XVIDC_VM_1920x1080_25_P},
+	{34, XVIDC_VM_1920x1080_30_P},
+	{40, XVIDC_VM_1920x1080_100_I},
+	{46, XVIDC_VM_1920x1080_120_I},
+	{60, XVIDC_VM_1280x720_24_P},
+	{61, XVIDC_VM_1280x720_25_P},
+	{62, XVIDC_VM_1280x720_30_P},
+	{63, XVIDC_VM_1920x1080_120_P},
+	{64, XVIDC_VM_1920x1080_100_P},
+	{65, XVIDC_VM_1280x720_24_P},
+	{66, XVIDC_VM_1280x720_25_P},
+	{67, XVIDC_VM_1280x720_30_P},
+	{68, XVIDC_VM_1280x720_50_P},
+	{69, XVIDC_VM_1280x720_60_P},
+	{72, XVIDC_VM_1920x1080_24_P},
+	{73, XVIDC_VM_1920x1080_25_P},
+	{74, XVIDC_VM_1920x1080_30_P},
+	{75, XVIDC_VM_1920x1080_50_P},
+	{76, XVIDC_VM_1920x1080_60_P},
+	{77, XVIDC_VM_1920x1080_100_P},
+	{78, XVIDC_VM_1920x1080_120_P},
+	{82, XVIDC_VM_1680x720_50_P},
+	{83, XVIDC_VM_1680x720_60_P},
+	{84, XVIDC_VM_1680x720_100_P},
+	{85, XVIDC_VM_1680x720_120_P},
+	{89, XVIDC_VM_2560x1080_50_P},
+	{90, XVIDC_VM_2560x1080_60_P},
+	{91, XVIDC_VM_2560x1080_100_P},
+	{92, XVIDC_VM_2560x1080_120_P},
+	{93, XVIDC_VM_3840x2160_24_P},
+	{94, XVIDC_VM_3840x2160_25_P},
+	{95, XVIDC_VM_3840x2160_30_P},
+	{96, XVIDC_VM_3840x2160_50_P},
+	{97, XVIDC_VM_3840x2160_60_P},
+	{98, XVIDC_VM_4096x2160_24_P},
+	{99, XVIDC_VM_4096x2160_25_P},
+	{100, XVIDC_VM_4096x2160_30_P},
+	{101, XVIDC_VM_4096x2160_50_P},
+	{102, XVIDC_VM_4096x2160_60_P},
+	{103, XVIDC_VM_3840x2160_24_P},
+	{104, XVIDC_VM_3840x2160_25_P},
+	{105, XVIDC_VM_3840x2160_30_P},
+	{106, XVIDC_VM_3840x2160_50_P},
+	{107, XVIDC_VM_3840x2160_60_P},
+	{111, XVIDC_VM_1920x1080_48_P},
+	{112, XVIDC_VM_1920x1080_48_P},
+	{114, XVIDC_VM_3840x2160_48_P},
+	{115, XVIDC_VM_4096x2160_48_P},
+	{116, XVIDC_VM_3840x2160_48_P},
+};
+
+/**
+ * HDMI VICs (HDMI 1.4b vendor-specific data block) and the CEA-861 VICs of the
+ * same timings.
+ */
+static const u8 XVidC_EdidHdmiVics[] = {
+	0, 95, 94, 93, 98,
+};
+
 /**************************** Function Definitions ****************************/
 
 /******************************************************************************/
@@ -379,242 +528,753 @@ u16 XVidC_EdidGetStdTimingsV(const u8 *EdidRaw, u8 StdTimingsNum)
  *		  in the supplied base EDID.
  *		- XST_FAILURE otherwise.
  *
- * @note	None.
+ * @note	This decodes the EDID timings on every call. To check several
+ *		video modes, decode the EDID once with XVidC_EdidParse().
  *
 *******************************************************************************/
 u32 XVidC_EdidIsVideoTimingSupported(const u8 *EdidRaw,
 		const XVidC_VideoTimingMode *VtMode)
 {
-	u32 Status;
+	XVidC_EdidCaps Caps;
 
-	/* Check if the video mode is the preferred timing. */
-	Status = XVidC_EdidIsVideoTimingSupportedPreferredTiming(EdidRaw,
-									VtMode);
-	if (Status == XST_SUCCESS) {
-		return Status;
+	XVidC_EdidDecodeTimings(EdidRaw, &Caps);
+	if (Caps.NumTimings == 0) {
+		return XST_FAILURE;
 	}
 
-	/* Check established timings I, II, and III. */
-	Status = XVidC_EdidIsVideoTimingSupportedEstablishedTimings(EdidRaw,
-									VtMode);
-	if (Status == XST_SUCCESS) {
-		return Status;
+	return XVidC_EdidCapsIsTimingAdvertised(&Caps, 0, Caps.NumTimings - 1,
+			VtMode) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/******************************************************************************/
+/**
+ * Decodes the supplied Extended Display Identification Data (EDID) once into a
+ * capability structure. The timings advertised by the base block are decoded,
+ * and every video mode of the video timing tables (including a registered
+ * custom table) that they support is marked in the capability's mode map.
+ *
+ * @param	EdidRaw is the supplied base EDID to decode.
+ * @param	Caps is the capability structure to fill in.
+ *
+ * @return
+ *		- XST_SUCCESS if the EDID was decoded.
+ *		- XST_FAILURE if the EDID header is invalid.
+ *
+ * @note	The mode map refers to video mode indices, so the EDID has to
+ *		be parsed again after the custom timing table changes.
+ *
+*******************************************************************************/
+u32 XVidC_EdidParse(const u8 *EdidRaw, XVidC_EdidCaps *Caps)
+{
+	/* Verify arguments. */
+	Xil_AssertNonvoid(EdidRaw != NULL);
+	Xil_AssertNonvoid(Caps != NULL);
+
+	memset(Caps, 0, sizeof(*Caps));
+
+	if (!XVidC_EdidIsHeaderValid(EdidRaw)) {
+		return XST_FAILURE;
 	}
 
-	/* Check in standard timings support. */
-	Status = XVidC_EdidIsVideoTimingSupportedStandardTimings(EdidRaw,
-									VtMode);
+	Caps->ColorDepth = XVidC_EdidGetColorDepth(EdidRaw);
+	Caps->ExtBlkCount = XVidC_EdidGetExtBlkCount(EdidRaw);
 
-	return Status;
+	XVidC_EdidDecodeTimings(EdidRaw, Caps);
+	XVidC_EdidCapsMarkModes(Caps, 0);
+
+	return XST_SUCCESS;
 }
 
 /******************************************************************************/
 /**
- * Checks whether or not a specified video timing mode is the preferred timing
- * of the supplied base Extended Display Identification Data (EDID).
+ * Decodes an extension block of the supplied Extended Display Identification
+ * Data (EDID) into a capability structure filled in by XVidC_EdidParse(). The
+ * detailed timings and video identification codes of CEA-861 extensions, and
+ * the type I and type VII detailed timings of DisplayID extensions, are added
+ * to the capability's timings and mode map. Other extensions are skipped.
  *
- * @param	EdidRaw is the supplied base EDID to check the timing against.
- * @param	VtMode is the video timing mode to check for support.
+ * @param	Caps is the capability structure decoded from the base block.
+ * @param	ExtRaw is the 128 byte extension block.
  *
  * @return
- *		- XST_SUCCESS if the video timing mode is the preferred timing
- *		  as specified in the base EDID.
- *		- XST_FAILURE otherwise.
+ *		- XST_SUCCESS if the extension block was decoded or skipped.
+ *		- XST_FAILURE if the capability structure has not been filled
+ *		  in from a base block.
+ *
+ * @note	Extension blocks can be passed in as they are read from the
+ *		sink, one at a time.
+ *
+*******************************************************************************/
+u32 XVidC_EdidParseExtBlock(XVidC_EdidCaps *Caps, const u8 *ExtRaw)
+{
+	u8 FirstTiming;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Caps != NULL);
+	Xil_AssertNonvoid(ExtRaw != NULL);
+
+	if (Caps->NumTimings == 0) {
+		return XST_FAILURE;
+	}
+
+	FirstTiming = Caps->NumTimings;
+
+	switch (ExtRaw[XVIDC_EDID_EXT_TAG]) {
+		case XVIDC_EDID_EXT_TAG_CEA:
+			XVidC_EdidParseCea(Caps, ExtRaw);
+			break;
+
+		case XVIDC_EDID_EXT_TAG_DISPLAYID:
+			XVidC_EdidParseDisplayId(Caps, ExtRaw);
+			break;
+
+		default:
+			break;
+	}
+
+	XVidC_EdidCapsMarkModes(Caps, FirstTiming);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * Checks whether or not a video mode is supported by a sink, as decoded by
+ * XVidC_EdidParse().
+ *
+ * @param	Caps is the capability structure decoded from the sink's EDID.
+ * @param	VmId specifies the resolution ID.
+ *
+ * @return	TRUE if the video mode is supported, FALSE otherwise.
  *
  * @note	None.
  *
 *******************************************************************************/
-static u32 XVidC_EdidIsVideoTimingSupportedPreferredTiming(const u8 *EdidRaw,
-		const XVidC_VideoTimingMode *VtMode)
+u8 XVidC_EdidCapsIsVideoModeSupported(const XVidC_EdidCaps *Caps,
+		XVidC_VideoMode VmId)
+{
+	int Index;
+
+	Index = XVidC_GetVideoModeIndex(VmId);
+	if (Index < 0) {
+		return FALSE;
+	}
+
+	return (Caps->ModeMap[Index / 32] >> (Index % 32)) & 0x1;
+}
+
+/******************************************************************************/
+/**
+ * Checks whether or not a sink supports a video mode only with YCbCr 4:2:0
+ * sampling, as listed in its CEA-861 YCbCr 4:2:0 video data block.
+ *
+ * @param	Caps is the capability structure decoded from the sink's EDID.
+ * @param	VmId specifies the resolution ID.
+ *
+ * @return	TRUE if the video mode is supported in 4:2:0 only, FALSE
+ *		otherwise.
+ *
+ * @note	XVidC_EdidCapsIsVideoModeSupported() and
+ *		XVidC_EdidCapsGetMaxVideoMode() do not report these modes.
+ *
+*******************************************************************************/
+u8 XVidC_EdidCapsIsVideoModeY420Only(const XVidC_EdidCaps *Caps,
+		XVidC_VideoMode VmId)
+{
+	int Index;
+
+	Index = XVidC_GetVideoModeIndex(VmId);
+	if (Index < 0) {
+		return FALSE;
+	}
+
+	return (Caps->Y420ModeMap[Index / 32] >> (Index % 32)) & 0x1;
+}
+
+/******************************************************************************/
+/**
+ * Returns the supported video mode of a sink with the highest pixel clock, as
+ * decoded by XVidC_EdidParse() and XVidC_EdidParseExtBlock().
+ *
+ * @param	Caps is the capability structure decoded from the sink's EDID.
+ *
+ * @return	ID of the video mode, or XVIDC_VM_NOT_SUPPORTED if no video
+ *		mode is supported.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+XVidC_VideoMode XVidC_EdidCapsGetMaxVideoMode(const XVidC_EdidCaps *Caps)
+{
+	const XVidC_VideoTimingMode *VtMode;
+	XVidC_VideoMode MaxVmId = XVIDC_VM_NOT_SUPPORTED;
+	u64 MaxClkMilliHz = 0;
+	u64 ClkMilliHz;
+	u16 NumModes;
+	u16 Index;
+
+	NumModes = XVidC_GetNumVideoModes();
+	for (Index = 0; Index < NumModes; Index++) {
+		if (!((Caps->ModeMap[Index / 32] >> (Index % 32)) & 0x1)) {
+			continue;
+		}
+		VtMode = XVidC_GetVideoModeDataByIndex(Index);
+		ClkMilliHz = XVidC_GetPixelClockMilliHzByVmId(VtMode->VmId);
+		if (ClkMilliHz > MaxClkMilliHz) {
+			MaxClkMilliHz = ClkMilliHz;
+			MaxVmId = VtMode->VmId;
+		}
+	}
+
+	return MaxVmId;
+}
+
+/******************************************************************************/
+/**
+ * Returns the video mode of a CEA-861 video identification code (VIC).
+ *
+ * @param	Vic is the video identification code.
+ *
+ * @return	ID of the video mode, or XVIDC_VM_NOT_SUPPORTED if the VIC has
+ *		no video mode in the video timing table.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+XVidC_VideoMode XVidC_EdidGetVicVideoMode(u8 Vic)
+{
+	u8 Index;
+
+	for (Index = 0; Index < ARRAY_SIZE(XVidC_EdidCeaVics); Index++) {
+		if (XVidC_EdidCeaVics[Index].Vic == Vic) {
+			return XVidC_EdidCeaVics[Index].VmId;
+		}
+	}
+
+	return XVIDC_VM_NOT_SUPPORTED;
+}
+
+/******************************************************************************/
+/**
+ * Decodes the preferred timing, established timings (I, II, and the
+ * manufacturer's timings) and standard timings of the supplied base Extended
+ * Display Identification Data (EDID) into the timing list of a capability
+ * structure.
+ *
+ * @param	EdidRaw is the supplied base EDID to decode.
+ * @param	Caps is the capability structure to add the timings to.
+ *
+ * @return	None.
+ *
+ * @note	The preferred timing matches any frame rate.
+ *
+*******************************************************************************/
+static void XVidC_EdidDecodeTimings(const u8 *EdidRaw, XVidC_EdidCaps *Caps)
 {
 	const u8 *Ptm;
+	u16 HActive;
+	u16 VActive;
+	u8 Index;
 
-	Ptm = &EdidRaw[XVIDC_EDID_PTM];
+	Caps->NumTimings = 0;
 
-	u32 HActive = (((Ptm[XVIDC_EDID_DTD_PTM_HRES_HBLANK_U4] &
+	/* Preferred timing. */
+	Ptm = &EdidRaw[XVIDC_EDID_PTM];
+	HActive = (((Ptm[XVIDC_EDID_DTD_PTM_HRES_HBLANK_U4] &
 			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_MASK) >>
 			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_SHIFT) << 8) |
 			Ptm[XVIDC_EDID_DTD_PTM_HRES_LSB];
-
-	u32 VActive = (((Ptm[XVIDC_EDID_DTD_PTM_VRES_VBLANK_U4] &
+	VActive = (((Ptm[XVIDC_EDID_DTD_PTM_VRES_VBLANK_U4] &
 			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_MASK) >>
 			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_SHIFT) << 8) |
 			Ptm[XVIDC_EDID_DTD_PTM_VRES_LSB];
+	XVidC_EdidAddTiming(Caps, HActive, VActive, 0,
+			XVidC_EdidIsDtdPtmInterlaced(EdidRaw));
+
+	/* Further detailed timing descriptors. */
+	for (Index = 2; Index <= 4; Index++) {
+		XVidC_EdidDecodeDtd(Caps,
+				&EdidRaw[XVIDC_EDID_18BYTE_DESCRIPTOR(Index)],
+				FALSE);
+	}
+
+	/* Established timings I, II, and III. */
+	for (Index = 0; Index < ARRAY_SIZE(XVidC_EdidEstTimings); Index++) {
+		if (EdidRaw[XVidC_EdidEstTimings[Index].Offset] &
+				XVidC_EdidEstTimings[Index].Mask) {
+			XVidC_EdidAddTiming(Caps,
+					XVidC_EdidEstTimings[Index].HActive,
+					XVidC_EdidEstTimings[Index].VActive,
+					XVidC_EdidEstTimings[Index].FrameRate,
+					FALSE);
+		}
+	}
 
-	if (VtMode->Timing.F1VTotal != XVidC_EdidIsDtdPtmInterlaced(EdidRaw)) {
-		return (XST_FAILURE);
+	/* Standard timings; unused entries are 0x0101. */
+	for (Index = 1; Index <= 8; Index++) {
+		if ((EdidRaw[XVIDC_EDID_STD_TIMINGS_H(Index)] == 0x01) &&
+			(EdidRaw[XVIDC_EDID_STD_TIMINGS_AR_FRR(Index)] == 0x01)) {
+			continue;
+		}
+		XVidC_EdidAddTiming(Caps,
+				XVidC_EdidGetStdTimingsH(EdidRaw, Index),
+				XVidC_EdidGetStdTimingsV(EdidRaw, Index),
+				XVidC_EdidGetStdTimingsFrr(EdidRaw, Index),
+				FALSE);
 	}
-	else if ((VtMode->Timing.HActive == HActive) &&
-			(VtMode->Timing.VActive == VActive)) {
-		return (XST_SUCCESS);
+}
+
+/******************************************************************************/
+/**
+ * Adds a timing to the timing list of a capability structure.
+ *
+ * @param	Caps is the capability structure.
+ * @param	HActive is the horizontal active resolution.
+ * @param	VActive is the vertical active resolution.
+ * @param	FrameRate is the frame rate in Hz, or 0 for any frame rate.
+ * @param	IsInterlaced specifies interlaced or progressive timing.
+ *
+ * @return	None.
+ *
+ * @note	Timings beyond XVIDC_EDID_MAX_TIMINGS are dropped.
+ *
+*******************************************************************************/
+static void XVidC_EdidAddTiming(XVidC_EdidCaps *Caps, u16 HActive,
+		u16 VActive, u8 FrameRate, u8 IsInterlaced)
+{
+	XVidC_EdidTimingId *TimingPtr;
+
+	if (Caps->NumTimings >= XVIDC_EDID_MAX_TIMINGS) {
+		return;
 	}
 
-	return XST_FAILURE;
+	TimingPtr = &Caps->Timings[Caps->NumTimings++];
+	TimingPtr->HActive = HActive;
+	TimingPtr->VActive = VActive;
+	TimingPtr->FrameRate = FrameRate;
+	TimingPtr->IsInterlaced = IsInterlaced;
 }
 
 /******************************************************************************/
 /**
- * Checks whether or not a specified video timing mode is supported in the
- * established timings field of the supplied base Extended Display
- * Identification Data (EDID).
+ * Checks whether or not a video timing mode matches one of a range of the
+ * timings in the timing list of a capability structure.
  *
- * @param	EdidRaw is the supplied base EDID to check the timing against.
+ * @param	Caps is the capability structure.
+ * @param	FirstTiming is the first timing of the range.
+ * @param	LastTiming is the last timing of the range.
  * @param	VtMode is the video timing mode to check for support.
  *
- * @return
- *		- XST_SUCCESS if the video timing mode is supported in the
- *		  base EDID's established timings field.
- *		- XST_FAILURE otherwise.
+ * @return	TRUE if a listed timing matches, FALSE otherwise.
  *
  * @note	None.
  *
 *******************************************************************************/
-static u32 XVidC_EdidIsVideoTimingSupportedEstablishedTimings(const u8 *EdidRaw,
+static u8 XVidC_EdidCapsIsTimingAdvertised(const XVidC_EdidCaps *Caps,
+		u8 FirstTiming, u8 LastTiming,
 		const XVidC_VideoTimingMode *VtMode)
 {
-	u32 Status = XST_FAILURE;
-
-	/* Check established timings I, II, and III. */
-	if ((VtMode->Timing.HActive == 800) &&
-			(VtMode->Timing.VActive == 640) &&
-			(VtMode->FrameRate == XVIDC_FR_56HZ) &&
-			XVidC_EdidSuppEstTimings800x600_56(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 640) &&
-			(VtMode->Timing.VActive == 480) &&
-			(VtMode->FrameRate == XVIDC_FR_60HZ) &&
-			XVidC_EdidSuppEstTimings640x480_60(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 800) &&
-			(VtMode->Timing.VActive == 600) &&
-			(VtMode->FrameRate == XVIDC_FR_60HZ) &&
-			XVidC_EdidSuppEstTimings800x600_60(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1024) &&
-			(VtMode->Timing.VActive == 768) &&
-			(VtMode->FrameRate == XVIDC_FR_60HZ) &&
-			XVidC_EdidSuppEstTimings1024x768_60(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 640) &&
-			(VtMode->Timing.VActive == 480) &&
-			(VtMode->FrameRate == XVIDC_FR_67HZ) &&
-			XVidC_EdidSuppEstTimings640x480_67(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 720) &&
-			(VtMode->Timing.VActive == 400) &&
-			(VtMode->FrameRate == XVIDC_FR_70HZ) &&
-			XVidC_EdidSuppEstTimings720x400_70(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1024) &&
-			(VtMode->Timing.VActive == 768) &&
-			(VtMode->FrameRate == XVIDC_FR_70HZ) &&
-			XVidC_EdidSuppEstTimings1024x768_70(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 640) &&
-			(VtMode->Timing.VActive == 480) &&
-			(VtMode->FrameRate == XVIDC_FR_72HZ) &&
-			XVidC_EdidSuppEstTimings640x480_72(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 800) &&
-			(VtMode->Timing.VActive == 600) &&
-			(VtMode->FrameRate == XVIDC_FR_72HZ) &&
-			XVidC_EdidSuppEstTimings800x600_72(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 640) &&
-			(VtMode->Timing.VActive == 480) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings640x480_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 800) &&
-			(VtMode->Timing.VActive == 600) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings800x600_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 832) &&
-			(VtMode->Timing.VActive == 624) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings832x624_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1024) &&
-			(VtMode->Timing.VActive == 768) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings1024x768_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1152) &&
-			(VtMode->Timing.VActive == 870) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings1152x870_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1280) &&
-			(VtMode->Timing.VActive == 1024) &&
-			(VtMode->FrameRate == XVIDC_FR_75HZ) &&
-			XVidC_EdidSuppEstTimings1280x1024_75(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 1024) &&
-			(VtMode->Timing.VActive == 768) &&
-			(VtMode->FrameRate == XVIDC_FR_87HZ) &&
-			XVidC_EdidSuppEstTimings1024x768_87(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-	else if ((VtMode->Timing.HActive == 720) &&
-			(VtMode->Timing.VActive == 400) &&
-			(VtMode->FrameRate == XVIDC_FR_88HZ) &&
-			XVidC_EdidSuppEstTimings720x400_88(EdidRaw)) {
-		Status = XST_SUCCESS;
-	}
-
-	return Status;
+	const XVidC_EdidTimingId *TimingPtr;
+	u8 IsInterlaced = (VtMode->Timing.F1VTotal != 0);
+	u16 Index;
+
+	for (Index = FirstTiming; Index <= LastTiming; Index++) {
+		TimingPtr = &Caps->Timings[Index];
+		if ((TimingPtr->HActive == VtMode->Timing.HActive) &&
+			(TimingPtr->VActive == VtMode->Timing.VActive) &&
+			(TimingPtr->IsInterlaced == IsInterlaced) &&
+			((TimingPtr->FrameRate == 0) ||
+			 (TimingPtr->FrameRate == VtMode->FrameRate))) {
+			return TRUE;
+		}
+	}
+
+	return FALSE;
 }
 
 /******************************************************************************/
 /**
- * Checks whether or not a specified video timing mode is supported in the
- * standard timings field of the supplied base Extended Display Identification
- * Data (EDID).
+ * Marks the video modes that match the timings of a capability structure,
+ * starting at a given timing, in the capability's mode map.
  *
- * @param	EdidRaw is the supplied base EDID to check the timing against.
- * @param	VtMode is the video timing mode to check for support.
+ * @param	Caps is the capability structure.
+ * @param	FirstTiming is the first timing to match video modes against.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static void XVidC_EdidCapsMarkModes(XVidC_EdidCaps *Caps, u8 FirstTiming)
+{
+	const XVidC_VideoTimingMode *VtMode;
+	u16 NumModes;
+	u16 Index;
+
+	if (FirstTiming >= Caps->NumTimings) {
+		return;
+	}
+
+	/* Only match against the timings added since FirstTiming. */
+	NumModes = XVidC_GetNumVideoModes();
+	for (Index = 0; Index < NumModes; Index++) {
+		VtMode = XVidC_GetVideoModeDataByIndex(Index);
+		if (XVidC_EdidCapsIsTimingAdvertised(Caps, FirstTiming,
+				Caps->NumTimings - 1, VtMode)) {
+			Caps->ModeMap[Index / 32] |= BIT(Index % 32);
+		}
+	}
+}
+
+/******************************************************************************/
+/**
+ * Marks the video mode of a CEA-861 video identification code (VIC) in the
+ * mode map of a capability structure.
+ *
+ * @param	Caps is the capability structure.
+ * @param	Vic is the video identification code.
+ * @param	Y420Only is TRUE if the sink supports the VIC only with YCbCr
+ *		4:2:0 sampling, FALSE otherwise.
+ *
+ * @return	None.
+ *
+ * @note	VICs without a video mode in the timing table are ignored.
+ *		4:2:0-only VICs go to the separate Y420ModeMap, as sources
+ *		sending RGB or 4:4:4 cannot use them.
+ *
+*******************************************************************************/
+static void XVidC_EdidCapsMarkVic(XVidC_EdidCaps *Caps, u8 Vic, u8 Y420Only)
+{
+	XVidC_VideoMode VmId;
+
+	VmId = XVidC_EdidGetVicVideoMode(Vic);
+	if (VmId == XVIDC_VM_NOT_SUPPORTED) {
+		return;
+	}
+
+	if (Y420Only) {
+		Caps->Y420ModeMap[VmId / 32] |= BIT(VmId % 32);
+	}
+	else {
+		Caps->ModeMap[VmId / 32] |= BIT(VmId % 32);
+	}
+}
+
+/******************************************************************************/
+/**
+ * Computes the frame rate of a timing from its pixel clock and totals.
+ *
+ * @param	ClkKhz is the pixel clock in kHz.
+ * @param	HTotal is the horizontal total in pixels.
+ * @param	VTotal is the vertical total in lines.
+ * @param	FrameRate is where the frame rate, rounded to Hz, is stored.
  *
  * @return
- *		- XST_SUCCESS if the video timing mode is supported in the
- *		  base EDID's standard timings fields.
- *		- XST_FAILURE otherwise.
+ *		- XST_SUCCESS if the frame rate was computed.
+ *		- XST_FAILURE if a total is 0 or the frame rate does not fit
+ *		  XVidC_EdidTimingId.
+ *
+ * @note	Totals and clock come straight from the sink's EDID.
+ *
+*******************************************************************************/
+static u32 XVidC_EdidGetFrameRate(u32 ClkKhz, u32 HTotal, u32 VTotal,
+		u8 *FrameRate)
+{
+	u64 Pixels;
+	u64 Rate;
+
+	if ((HTotal == 0) || (VTotal == 0)) {
+		return XST_FAILURE;
+	}
+
+	Pixels = (u64)HTotal * VTotal;
+	Rate = div64_u64(((u64)ClkKhz * 1000) + (Pixels / 2), Pixels);
+	if (Rate > U8_MAX) {
+		return XST_FAILURE;
+	}
+
+	*FrameRate = Rate;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * Decodes an 18 byte detailed timing descriptor (DTD) into the timings of a
+ * capability structure.
+ *
+ * @param	Caps is the capability structure.
+ * @param	Dtd is the detailed timing descriptor.
+ * @param	AnyRate specifies whether the timing matches any frame rate
+ *		(preferred timing) or only its own.
+ *
+ * @return	None.
+ *
+ * @note	Display descriptors (pixel clock of 0) are skipped. The frame
+ *		rate of an interlaced timing is its field rate, as in the video
+ *		timing table.
+ *
+*******************************************************************************/
+static void XVidC_EdidDecodeDtd(XVidC_EdidCaps *Caps, const u8 *Dtd,
+		u8 AnyRate)
+{
+	u32 ClkKhz;
+	u16 HActive;
+	u16 HBlank;
+	u16 VActive;
+	u16 VBlank;
+	u8 FrameRate;
+
+	ClkKhz = ((Dtd[XVIDC_EDID_DTD_PTM_PIXEL_CLK_KHZ_MSB] << 8) |
+			Dtd[XVIDC_EDID_DTD_PTM_PIXEL_CLK_KHZ_LSB]) * 10;
+	if (ClkKhz == 0) {
+		return;
+	}
+
+	HActive = (((Dtd[XVIDC_EDID_DTD_PTM_HRES_HBLANK_U4] &
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_MASK) >>
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_SHIFT) << 8) |
+			Dtd[XVIDC_EDID_DTD_PTM_HRES_LSB];
+	HBlank = ((Dtd[XVIDC_EDID_DTD_PTM_HRES_HBLANK_U4] &
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XBLANK_MASK) << 8) |
+			Dtd[XVIDC_EDID_DTD_PTM_HBLANK_LSB];
+	VActive = (((Dtd[XVIDC_EDID_DTD_PTM_VRES_VBLANK_U4] &
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_MASK) >>
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XRES_SHIFT) << 8) |
+			Dtd[XVIDC_EDID_DTD_PTM_VRES_LSB];
+	VBlank = ((Dtd[XVIDC_EDID_DTD_PTM_VRES_VBLANK_U4] &
+			XVIDC_EDID_DTD_PTM_XRES_XBLANK_U4_XBLANK_MASK) << 8) |
+			Dtd[XVIDC_EDID_DTD_PTM_VBLANK_LSB];
+
+	if (AnyRate) {
+		FrameRate = 0;
+	}
+	else if (XVidC_EdidGetFrameRate(ClkKhz, HActive + HBlank,
+			VActive + VBlank, &FrameRate) != XST_SUCCESS) {
+		/* Malformed descriptor. */
+		return;
+	}
+
+	XVidC_EdidAddTiming(Caps, HActive, VActive, FrameRate,
+			(Dtd[XVIDC_EDID_DTD_PTM_SIGNAL] &
+			XVIDC_EDID_DTD_PTM_SIGNAL_INTERLACED_MASK) ? 1 : 0);
+}
+
+/******************************************************************************/
+/**
+ * Decodes a CEA-861 extension block: the short video descriptors of the video
+ * and YCbCr 4:2:0 video data blocks, the HDMI VICs of the HDMI vendor-specific
+ * data block, and the detailed timing descriptors.
+ *
+ * @param	Caps is the capability structure.
+ * @param	ExtRaw is the 128 byte CEA-861 extension block.
+ *
+ * @return	None.
  *
  * @note	None.
  *
 *******************************************************************************/
-static u32 XVidC_EdidIsVideoTimingSupportedStandardTimings(const u8 *EdidRaw,
-		const XVidC_VideoTimingMode *VtMode)
+static void XVidC_EdidParseCea(XVidC_EdidCaps *Caps, const u8 *ExtRaw)
 {
+	const u8 *Db;
+	u8 DtdOffset;
+	u8 Offset;
+	u8 Tag;
+	u8 Len;
+	u8 Svd;
 	u8 Index;
 
-	for (Index = 0; Index < 8; Index++) {
-		if ((VtMode->Timing.HActive ==
-			XVidC_EdidGetStdTimingsH(EdidRaw, Index + 1)) &&
-			(VtMode->Timing.VActive ==
-				XVidC_EdidGetStdTimingsV(EdidRaw, Index + 1)) &&
-			(VtMode->FrameRate == (u8)XVidC_EdidGetStdTimingsFrr(
-							EdidRaw, Index + 1))) {
-			return XST_SUCCESS;
+	DtdOffset = ExtRaw[XVIDC_EDID_CEA_DTD_OFFSET];
+	if ((DtdOffset == 0) || (DtdOffset > XVIDC_EDID_BLOCK_SIZE - 1)) {
+		/* No data block collection and no detailed timings. */
+		return;
+	}
+
+	/* Data block collection. */
+	for (Offset = XVIDC_EDID_CEA_DBC; Offset < DtdOffset;
+			Offset += Len + 1) {
+		Db = &ExtRaw[Offset];
+		Tag = Db[0] >> XVIDC_EDID_CEA_DB_TAG_SHIFT;
+		Len = Db[0] & XVIDC_EDID_CEA_DB_LEN_MASK;
+		if (Offset + Len >= DtdOffset) {
+			break;
+		}
+
+		switch (Tag) {
+			case XVIDC_EDID_CEA_DB_VIDEO:
+				for (Index = 1; Index <= Len; Index++) {
+					Svd = Db[Index];
+					/* Bit 7 flags a native VIC 1-64. */
+					if ((Svd > 128) && (Svd <= 192)) {
+						Svd &= ~XVIDC_EDID_CEA_SVD_NATIVE_MASK;
+					}
+					XVidC_EdidCapsMarkVic(Caps, Svd, FALSE);
+				}
+				break;
+
+			case XVIDC_EDID_CEA_DB_VSDB:
+				XVidC_EdidParseCeaHdmiVsdb(Caps, Db, Len);
+				break;
+
+			case XVIDC_EDID_CEA_DB_EXTENDED:
+				if ((Len < 1) || (Db[1] !=
+					XVIDC_EDID_CEA_EXT_DB_Y420_VIDEO)) {
+					break;
+				}
+				/* These VICs are YCbCr 4:2:0 only. */
+				for (Index = 2; Index <= Len; Index++) {
+					XVidC_EdidCapsMarkVic(Caps, Db[Index],
+							TRUE);
+				}
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	/* Detailed timing descriptors, up to the checksum byte. */
+	for (Offset = DtdOffset; Offset + XVIDC_EDID_DTD_SIZE <=
+			XVIDC_EDID_BLOCK_SIZE - 1;
+			Offset += XVIDC_EDID_DTD_SIZE) {
+		if ((ExtRaw[Offset] == 0) && (ExtRaw[Offset + 1] == 0)) {
+			break;
+		}
+		XVidC_EdidDecodeDtd(Caps, &ExtRaw[Offset], FALSE);
+	}
+}
+
+/******************************************************************************/
+/**
+ * Decodes the HDMI VICs of an HDMI vendor-specific data block.
+ *
+ * @param	Caps is the capability structure.
+ * @param	Db is the data block, starting with its header byte.
+ * @param	Len is the length of the data block payload.
+ *
+ * @return	None.
+ *
+ * @note	Other vendor-specific data blocks are skipped.
+ *
+*******************************************************************************/
+static void XVidC_EdidParseCeaHdmiVsdb(XVidC_EdidCaps *Caps, const u8 *Db,
+		u8 Len)
+{
+	u8 Offset;
+	u8 VicLen;
+	u8 Vic;
+
+	if ((Len < 8) || (((Db[3] << 16) | (Db[2] << 8) | Db[1]) !=
+				XVIDC_EDID_CEA_HDMI_OUI)) {
+		return;
+	}
+	if (!(Db[8] & XVIDC_EDID_CEA_HDMI_VIDEO_MASK)) {
+		return;
+	}
+
+	/* Skip the latency fields to the HDMI video fields. */
+	Offset = 9;
+	if (Db[8] & XVIDC_EDID_CEA_HDMI_LATENCY_MASK) {
+		Offset += 2;
+	}
+	if (Db[8] & XVIDC_EDID_CEA_HDMI_I_LATENCY_MASK) {
+		Offset += 2;
+	}
+	if (Offset + 1 > Len) {
+		return;
+	}
+
+	VicLen = Db[Offset + 1] >> XVIDC_EDID_CEA_HDMI_VIC_LEN_SHIFT;
+	for (Offset += 2; VicLen && (Offset <= Len); VicLen--, Offset++) {
+		Vic = Db[Offset];
+		if ((Vic > 0) && (Vic < ARRAY_SIZE(XVidC_EdidHdmiVics))) {
+			XVidC_EdidCapsMarkVic(Caps, XVidC_EdidHdmiVics[Vic],
+					FALSE);
 		}
 	}
+}
+
+/******************************************************************************/
+/**
+ * Decodes the type I (DisplayID 1.3) and type VII (DisplayID 2.0) detailed
+ * timings of a DisplayID extension block.
+ *
+ * @param	Caps is the capability structure.
+ * @param	ExtRaw is the 128 byte DisplayID extension block.
+ *
+ * @return	None.
+ *
+ * @note	Interlaced DisplayID timings are skipped.
+ *
+*******************************************************************************/
+static void XVidC_EdidParseDisplayId(XVidC_EdidCaps *Caps, const u8 *ExtRaw)
+{
+	const u8 *Section;
+	const u8 *Db;
+	const u8 *Dt;
+	u8 SectionLen;
+	u8 Offset;
+	u8 Len;
+	u8 Index;
+	u32 ClkKhz;
+	u32 HActive;
+	u32 HTotal;
+	u32 VActive;
+	u32 VTotal;
+	u8 FrameRate;
+
+	/* The section (header, data blocks, checksum) has to fit in front of
+	 * the extension block checksum. */
+	Section = &ExtRaw[XVIDC_EDID_DID_SECTION];
+	SectionLen = XVIDC_EDID_DID_SECTION_HDR + Section[1];
+	if (XVIDC_EDID_DID_SECTION + SectionLen + 1 >
+			XVIDC_EDID_BLOCK_SIZE - 1) {
+		return;
+	}
 
-	return XST_FAILURE;
+	for (Offset = XVIDC_EDID_DID_SECTION_HDR;
+			Offset + XVIDC_EDID_DID_DB_HDR <= SectionLen;
+			Offset += XVIDC_EDID_DID_DB_HDR + Len) {
+		Db = &Section[Offset];
+		Len = Db[2];
+		if ((Db[0] == 0) ||
+			(Offset + XVIDC_EDID_DID_DB_HDR + Len > SectionLen)) {
+			break;
+		}
+		if ((Db[0] != XVIDC_EDID_DID_DB_TYPE_I) &&
+				(Db[0] != XVIDC_EDID_DID_DB_TYPE_VII)) {
+			continue;
+		}
+
+		for (Index = 0; Index + XVIDC_EDID_DID_TIMING_SIZE <= Len;
+				Index += XVIDC_EDID_DID_TIMING_SIZE) {
+			Dt = &Db[XVIDC_EDID_DID_DB_HDR + Index];
+			if (Dt[3] & XVIDC_EDID_DID_TIMING_INTERLACED_MASK) {
+				continue;
+			}
+
+			/* Pixel clock in 10 kHz (type I) or 1 kHz (type VII)
+			 * units, minus one. */
+			ClkKhz = ((Dt[2] << 16) | (Dt[1] << 8) | Dt[0]) + 1;
+			if (Db[0] == XVIDC_EDID_DID_DB_TYPE_I) {
+				ClkKhz *= 10;
+			}
+			HActive = ((Dt[5] << 8) | Dt[4]) + 1;
+			HTotal = HActive + ((Dt[7] << 8) | Dt[6]) + 1;
+			VActive = ((Dt[13] << 8) | Dt[12]) + 1;
+			VTotal = VActive + ((Dt[15] << 8) | Dt[14]) + 1;
+
+			/* Skip timings XVidC_EdidTimingId cannot hold. */
+			if ((HActive > U16_MAX) || (VActive > U16_MAX) ||
+				(XVidC_EdidGetFrameRate(ClkKhz, HTotal,
+					VTotal, &FrameRate) != XST_SUCCESS)) {
+				continue;
+			}
+
+			XVidC_EdidAddTiming(Caps, HActive, VActive,
+					FrameRate, FALSE);
+		}
+	}
 }
 
 /******************************************************************************/
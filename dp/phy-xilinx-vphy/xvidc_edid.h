@@ -241,6 +241,72 @@ extern "C" {
 #define XVIDC_EDID_DTD_PTM_SIGNAL_VPOLARITY_SHIFT		2
 /* @} */
 
+/** @name Extension blocks: CEA-861 and DisplayID.
+ * @{
+ */
+#define XVIDC_EDID_BLOCK_SIZE				128
+#define XVIDC_EDID_DTD_SIZE				18
+#define XVIDC_EDID_EXT_TAG				0x00
+#define XVIDC_EDID_EXT_TAG_CEA				0x02
+#define XVIDC_EDID_EXT_TAG_DISPLAYID			0x70
+#define XVIDC_EDID_CEA_DTD_OFFSET			0x02
+#define XVIDC_EDID_CEA_DBC				0x04
+#define XVIDC_EDID_CEA_DB_TAG_SHIFT			5
+#define XVIDC_EDID_CEA_DB_LEN_MASK			0x1F
+#define XVIDC_EDID_CEA_DB_VIDEO				0x2
+#define XVIDC_EDID_CEA_DB_VSDB				0x3
+#define XVIDC_EDID_CEA_DB_EXTENDED			0x7
+#define XVIDC_EDID_CEA_EXT_DB_Y420_VIDEO		0x0E
+#define XVIDC_EDID_CEA_SVD_NATIVE_MASK			0x80
+#define XVIDC_EDID_CEA_HDMI_OUI				0x000C03
+#define XVIDC_EDID_CEA_HDMI_LATENCY_MASK		0x80
+#define XVIDC_EDID_CEA_HDMI_I_LATENCY_MASK		0x40
+#define XVIDC_EDID_CEA_HDMI_VIDEO_MASK			0x20
+#define XVIDC_EDID_CEA_HDMI_VIC_LEN_SHIFT		5
+#define XVIDC_EDID_DID_SECTION				0x01
+#define XVIDC_EDID_DID_SECTION_HDR			4
+#define XVIDC_EDID_DID_DB_HDR				3
+#define XVIDC_EDID_DID_DB_TYPE_I			0x03
+#define XVIDC_EDID_DID_DB_TYPE_VII			0x22
+#define XVIDC_EDID_DID_TIMING_SIZE			20
+#define XVIDC_EDID_DID_TIMING_INTERLACED_MASK		0x10
+/* @} */
+
+/** @name Parsed EDID capabilities.
+ * @{
+ */
+#define XVIDC_EDID_MAX_TIMINGS		64
+#define XVIDC_EDID_MODE_MAP_WORDS	((XVIDC_VM_NUM_SUPPORTED + \
+					XVIDC_MAX_CUSTOM_MODES + 31) / 32)
+/* @} */
+
+/****************************** Type Definitions ******************************/
+
+/**
+ * A video timing advertised by an EDID, as far as it identifies a video mode.
+ */
+typedef struct {
+	u16 HActive;
+	u16 VActive;
+	u8 FrameRate;		/**< 0 if any frame rate matches. */
+	u8 IsInterlaced;
+} XVidC_EdidTimingId;
+
+/**
+ * Sink capabilities decoded once from an EDID by XVidC_EdidParse().
+ */
+typedef struct {
+	XVidC_EdidTimingId Timings[XVIDC_EDID_MAX_TIMINGS];
+	u8 NumTimings;
+	XVidC_ColorDepth ColorDepth;
+	u8 ExtBlkCount;
+	u32 ModeMap[XVIDC_EDID_MODE_MAP_WORDS];	/**< Supported video modes,
+						  *  by video mode index. */
+	u32 Y420ModeMap[XVIDC_EDID_MODE_MAP_WORDS];	/**< Video modes
+							  *  supported in YCbCr
+							  *  4:2:0 only. */
+} XVidC_EdidCaps;
+
 /******************* Macros (Inline Functions) Definitions ********************/
 
 #define XVidC_EdidIsHeaderValid(E) \
@@ -449,6 +515,14 @@ u16 XVidC_EdidGetStdTimingsV(const u8 *EdidRaw, u8 StdTimingsNum);
 /* Utility functions. */
 u32 XVidC_EdidIsVideoTimingSupported(const u8 *EdidRaw,
 		const XVidC_VideoTimingMode *VtMode);
+u32 XVidC_EdidParse(const u8 *EdidRaw, XVidC_EdidCaps *Caps);
+u32 XVidC_EdidParseExtBlock(XVidC_EdidCaps *Caps, const u8 *ExtRaw);
+u8 XVidC_EdidCapsIsVideoModeSupported(const XVidC_EdidCaps *Caps,
+		XVidC_VideoMode VmId);
+u8 XVidC_EdidCapsIsVideoModeY420Only(const XVidC_EdidCaps *Caps,
+		XVidC_VideoMode VmId);
+XVidC_VideoMode XVidC_EdidCapsGetMaxVideoMode(const XVidC_EdidCaps *Caps);
+XVidC_VideoMode XVidC_EdidGetVicVideoMode(u8 Vic);
 
 #ifdef __cplusplus
 }
@@ -60,6 +60,7 @@
  *    14) Frame 1: Vertical back porch (lines)
  *    15) Frame 1: Vertical total (lines)
  *    16) Vertical sync polarity (0=negative|1=positive)
+ * 5) Flags: XVIDC_VM_FLAG_<RB|RB2|INTERLACED|3D>, omitted when none apply
  */
 #ifdef __cplusplus
 extern "C"
@@ -69,52 +70,68 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 	/* Interlaced modes. */
 	{ XVIDC_VM_720x480_60_I, "720x480@60Hz (I)", XVIDC_FR_60HZ,
 		{720, 19, 62, 57, 858, 0,
-		240, 4, 3, 15, 262, 5, 3, 15, 263, 0} },
+		240, 4, 3, 15, 262, 5, 3, 15, 263, 0},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_720x576_50_I, "720x576@50Hz (I)", XVIDC_FR_50HZ,
 		{720, 12, 63, 69, 864, 0,
-		288, 2, 3, 19, 312, 3, 3, 19, 313, 0} },
+		288, 2, 3, 19, 312, 3, 3, 19, 313, 0},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1440x480_60_I, "1440x480@60Hz (I)", XVIDC_FR_60HZ,
 		{1440, 38, 124, 114, 1716, 0,
-		240, 4, 3, 15, 262, 5, 3, 15, 263, 0} },
+		240, 4, 3, 15, 262, 5, 3, 15, 263, 0},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1440x576_50_I, "1440x576@50Hz (I)", XVIDC_FR_50HZ,
 		{1440, 24, 126, 138, 1728, 0,
-		288, 2, 3, 19, 312, 3, 3, 19, 313, 0} },
+		288, 2, 3, 19, 312, 3, 3, 19, 313, 0},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1920x1080_48_I, "1920x1080@48Hz (I)", XVIDC_FR_48HZ,
 		{1920, 371, 88, 371, 2750, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1920x1080_50_I, "1920x1080@50Hz (I)", XVIDC_FR_50HZ,
 		{1920, 528, 44, 148, 2640, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED | XVIDC_VM_FLAG_3D },
 	{ XVIDC_VM_1920x1080_60_I, "1920x1080@60Hz (I)", XVIDC_FR_60HZ,
 		{1920, 88, 44, 148, 2200, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED | XVIDC_VM_FLAG_3D },
 	{ XVIDC_VM_1920x1080_96_I, "1920x1080@96Hz (I)", XVIDC_FR_96HZ,
 		{1920, 371, 88, 371, 2750, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1920x1080_100_I, "1920x1080@100Hz (I)", XVIDC_FR_100HZ,
 		{1920, 528, 44, 148, 2640, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_1920x1080_120_I, "1920x1080@120Hz (I)", XVIDC_FR_120HZ,
 		{1920, 88, 44, 148, 2200, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_48_I, "2048x1080@48Hz (I)", XVIDC_FR_48HZ,
 		{2048, 329, 44, 329, 2750, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_50_I, "2048x1080@50Hz (I)", XVIDC_FR_50HZ,
 		{2048, 274, 44, 274, 2640, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_60_I, "2048x1080@60Hz (I)", XVIDC_FR_60HZ,
 		{2048, 66, 20, 66, 2200, 1,
-		540, 2, 5, 15, 562, 3, 5, 15, 563, 1} },
+		540, 2, 5, 15, 562, 3, 5, 15, 563, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_96_I, "2048x1080@96Hz (I)", XVIDC_FR_96HZ,
 		{2048, 329, 44, 329, 2750, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_100_I, "2048x1080@100Hz (I)", XVIDC_FR_100HZ,
 		{2048, 274, 44, 274, 2640, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 	{ XVIDC_VM_2048x1080_120_I, "2048x1080@120Hz (I)", XVIDC_FR_120HZ,
 		{2048, 66, 20, 66, 2200, 1,
-		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1} },
+		1080, 4, 10, 30, 1124, 6, 10, 30, 1126, 1},
+		XVIDC_VM_FLAG_INTERLACED },
 
 
 	/* Progressive modes. */
@@ -159,7 +176,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		600, 1, 3, 27, 631, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_800x600_120_P_RB, "800x600@120Hz (RB)", XVIDC_FR_120HZ,
 		{800, 48, 32, 80, 960, 1,
-		600, 3, 4, 29, 636, 0, 0, 0, 0, 0} },
+		600, 3, 4, 29, 636, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_848x480_60_P, "848x480@60Hz", XVIDC_FR_60HZ,
 		{848, 16, 112, 112, 1088, 1,
 		480, 6, 8, 23, 517, 0, 0, 0, 0, 1} },
@@ -177,7 +195,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		768, 1, 3, 36, 808, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1024x768_120_P_RB, "1024x768@120Hz (RB)", XVIDC_FR_120HZ,
 		{1024, 48, 32, 80, 1184, 1,
-		768, 3, 4, 38, 813, 0, 0, 0, 0, 0} },
+		768, 3, 4, 38, 813, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1152x864_75_P, "1152x864@75Hz", XVIDC_FR_75HZ,
 		{1152, 64, 128, 256, 1600, 1,
 		864, 1, 3, 32, 900, 0, 0, 0, 0, 1} },
@@ -192,16 +211,19 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		720, 5, 5, 20, 750, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x720_50_P, "1280x720@50Hz", XVIDC_FR_50HZ,
 		{1280, 440, 40, 220, 1980, 1,
-		720, 5, 5, 20, 750, 0, 0, 0, 0, 1} },
+		720, 5, 5, 20, 750, 0, 0, 0, 0, 1},
+		XVIDC_VM_FLAG_3D },
 	{ XVIDC_VM_1280x720_60_P, "1280x720@60Hz", XVIDC_FR_60HZ,
 		{1280, 110, 40, 220, 1650, 1,
-		720, 5, 5, 20, 750, 0, 0, 0, 0, 1} },
+		720, 5, 5, 20, 750, 0, 0, 0, 0, 1},
+		XVIDC_VM_FLAG_3D },
 	{ XVIDC_VM_1280x768_60_P, "1280x768@60Hz", XVIDC_FR_60HZ,
 		{1280, 64, 128, 192, 1664, 0,
 		768, 3, 7, 20, 798, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x768_60_P_RB, "1280x768@60Hz (RB)", XVIDC_FR_60HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		768, 3, 7, 12, 790, 0, 0, 0, 0, 0} },
+		768, 3, 7, 12, 790, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1280x768_75_P, "1280x768@75Hz", XVIDC_FR_75HZ,
 		{1280, 80, 128, 208, 1696, 0,
 		768, 3, 7, 27, 805, 0, 0, 0, 0, 1} },
@@ -210,13 +232,15 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		768, 3, 7, 31, 809, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x768_120_P_RB, "1280x768@120Hz (RB)", XVIDC_FR_120HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		768, 3, 7, 35, 813, 0, 0, 0, 0, 0} },
+		768, 3, 7, 35, 813, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1280x800_60_P, "1280x800@60Hz", XVIDC_FR_60HZ,
 		{1280, 72, 128, 200, 1680, 0,
 		800, 3, 6, 22, 831, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x800_60_P_RB, "1280x800@60Hz (RB)", XVIDC_FR_60HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		800, 3, 6, 14, 823, 0, 0, 0, 0, 0} },
+		800, 3, 6, 14, 823, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1280x800_75_P, "1280x800@75Hz", XVIDC_FR_75HZ,
 		{1280, 80, 128, 208, 1696, 0,
 		800, 3, 6, 29, 838, 0, 0, 0, 0, 1} },
@@ -225,7 +249,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		800, 3, 6, 34, 843, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x800_120_P_RB, "1280x800@120Hz (RB)", XVIDC_FR_120HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		800, 3, 6, 38, 847, 0, 0, 0, 0, 0} },
+		800, 3, 6, 38, 847, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1280x960_60_P, "1280x960@60Hz", XVIDC_FR_60HZ,
 		{1280, 96, 112, 312, 1800, 1,
 		960, 1, 3, 36, 1000, 0, 0, 0, 0, 1} },
@@ -234,7 +259,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		960, 1, 3, 47, 1011, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x960_120_P_RB, "1280x960@120Hz (RB)", XVIDC_FR_120HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		960, 3, 4, 50, 1017, 0, 0, 0, 0, 0} },
+		960, 3, 4, 50, 1017, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1280x1024_60_P, "1280x1024@60Hz", XVIDC_FR_60HZ,
 		{1280, 48, 112, 248, 1688, 1,
 		1024, 1, 3, 38, 1066, 0, 0, 0, 0, 1} },
@@ -246,25 +272,29 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1024, 1, 3, 44, 1072, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1280x1024_120_P_RB, "1280x1024@120Hz (RB)", XVIDC_FR_120HZ,
 		{1280, 48, 32, 80, 1440, 1,
-		1024, 3, 7, 50, 1084, 0, 0, 0, 0, 0} },
+		1024, 3, 7, 50, 1084, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1360x768_60_P, "1360x768@60Hz", XVIDC_FR_60HZ,
 		{1360, 64, 112, 256, 1792, 1,
 		768, 3, 6, 18, 795, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1360x768_120_P_RB, "1360x768@120Hz (RB)", XVIDC_FR_120HZ,
 		{1360, 48, 32, 80, 1520, 1,
-		768, 3, 5, 37, 813, 0, 0, 0, 0, 0} },
+		768, 3, 5, 37, 813, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1366x768_60_P, "1366x768@60Hz", XVIDC_FR_60HZ,
 		{1366, 70, 143, 213, 1792, 1,
 		768, 3, 3, 24, 798, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1366x768_60_P_RB, "1366x768@60Hz (RB)", XVIDC_FR_60HZ,
 		{1366, 14, 56, 64, 1500, 1,
-		768, 1, 3, 28, 800, 0, 0, 0, 0, 1} },
+		768, 1, 3, 28, 800, 0, 0, 0, 0, 1},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1400x1050_60_P, "1400x1050@60Hz", XVIDC_FR_60HZ,
 		{1400, 88, 144, 232, 1864, 0,
 		1050, 3, 4, 32, 1089, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1400x1050_60_P_RB, "1400x1050@60Hz (RB)", XVIDC_FR_60HZ,
 		{1400, 48, 32, 80, 1560, 1,
-		1050, 3, 4, 23, 1080, 0, 0, 0, 0, 0} },
+		1050, 3, 4, 23, 1080, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1400x1050_75_P, "1400x1050@75Hz", XVIDC_FR_75HZ,
 		{1400, 104, 144, 248, 1896, 0,
 		1050, 3, 4, 42, 1099, 0, 0, 0, 0, 1} },
@@ -273,7 +303,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1050, 3, 4, 48, 1105, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1400x1050_120_P_RB, "1400x1050@120Hz (RB)", XVIDC_FR_120HZ,
 		{1400, 48, 32, 80, 1560, 1,
-		1050, 3, 4, 55, 1112, 0, 0, 0, 0, 0} },
+		1050, 3, 4, 55, 1112, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1440x240_60_P, "1440x240@60Hz", XVIDC_FR_60HZ,
 		{1440, 38, 124, 114, 1716, 0,
 		240, 14, 3, 4, 262, 0, 0, 0, 0, 1} },
@@ -282,7 +313,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		900, 3, 6, 25, 934, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1440x900_60_P_RB, "1440x900@60Hz (RB)", XVIDC_FR_60HZ,
 		{1440, 48, 32, 80, 1600, 1,
-		900, 3, 6, 17, 926, 0, 0, 0, 0, 0} },
+		900, 3, 6, 17, 926, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1440x900_75_P, "1440x900@75Hz", XVIDC_FR_75HZ,
 		{1440, 96, 152, 248, 1936, 0,
 		900, 3, 6, 33, 942, 0, 0, 0, 0, 1} },
@@ -291,7 +323,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		900, 3, 6, 39, 948, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1440x900_120_P_RB, "1440x900@120Hz (RB)", XVIDC_FR_120HZ,
 		{1440, 48, 32, 80, 1600, 1,
-		900, 3, 6, 44, 953, 0, 0, 0, 0, 0} },
+		900, 3, 6, 44, 953, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1600x1200_60_P, "1600x1200@60Hz", XVIDC_FR_60HZ,
 		{1600, 64, 192, 304, 2160, 1,
 		1200, 1, 3, 46, 1250, 0, 0, 0, 0, 1} },
@@ -309,7 +342,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1200, 1, 3, 46, 1250, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1600x1200_120_P_RB, "1600x1200@120Hz (RB)", XVIDC_FR_120HZ,
 		{1600, 48, 32, 80, 1760, 1,
-		1200, 3, 4, 64, 1271, 0, 0, 0, 0, 0} },
+		1200, 3, 4, 64, 1271, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1680x720_50_P, "1680x720@50Hz", XVIDC_FR_50HZ,
 		{1680, 260, 40, 220, 2200, 1,
 		720, 5, 5, 20, 750, 0, 0, 0, 0, 1} },
@@ -330,7 +364,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1050, 3, 6, 30, 1089, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1680x1050_60_P_RB, "1680x1050@60Hz (RB)", XVIDC_FR_60HZ,
 		{1680, 48, 32, 80, 1840, 1,
-		1050, 3, 6, 21, 1080, 0, 0, 0, 0, 0} },
+		1050, 3, 6, 21, 1080, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1680x1050_75_P, "1680x1050@75Hz", XVIDC_FR_75HZ,
 		{1680, 120, 176, 296, 2272, 0,
 		1050, 3, 6, 40, 1099, 0, 0, 0, 0, 1} },
@@ -339,7 +374,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1050, 3, 6, 46, 1105, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1680x1050_120_P_RB, "1680x1050@120Hz (RB)", XVIDC_FR_120HZ,
 		{1680, 48, 32, 80, 1840, 1,
-		1050, 3, 6, 53, 1112, 0, 0, 0, 0, 0} },
+		1050, 3, 6, 53, 1112, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1792x1344_60_P, "1792x1344@60Hz", XVIDC_FR_60HZ,
 		{1792, 128, 200, 328, 2448, 0,
 		1344, 1, 3, 46, 1394, 0, 0, 0, 0, 1} },
@@ -348,7 +384,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1344, 1, 3, 69, 1417, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1792x1344_120_P_RB, "1792x1344@120Hz (RB)", XVIDC_FR_120HZ,
 		{1792, 48, 32, 80, 1952, 1,
-		1344, 3, 4, 72, 1423, 0, 0, 0, 0, 0} },
+		1344, 3, 4, 72, 1423, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1856x1392_60_P, "1856x1392@60Hz", XVIDC_FR_60HZ,
 		{1856, 96, 224, 352, 2528, 0,
 		1392, 1, 3, 43, 1439, 0, 0, 0, 0, 1} },
@@ -357,10 +394,12 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1392, 1, 3, 104, 1500, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1856x1392_120_P_RB, "1856x1392@120Hz (RB)", XVIDC_FR_120HZ,
 		{1856, 48, 32, 80, 2016, 1,
-		1392, 3, 4, 75, 1474, 0, 0, 0, 0, 0} },
+		1392, 3, 4, 75, 1474, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1920x1080_24_P, "1920x1080@24Hz", XVIDC_FR_24HZ,
 		{1920, 638, 44, 148, 2750, 1,
-		1080, 4, 5, 36, 1125, 0, 0, 0, 0, 1} },
+		1080, 4, 5, 36, 1125, 0, 0, 0, 0, 1},
+		XVIDC_VM_FLAG_3D },
 	{ XVIDC_VM_1920x1080_25_P, "1920x1080@25Hz", XVIDC_FR_25HZ,
 		{1920, 528, 44, 148, 2640, 1,
 		1080, 4, 5, 36, 1125, 0, 0, 0, 0, 1} },
@@ -387,7 +426,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1200, 3, 6, 36, 1245, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1920x1200_60_P_RB, "1920x1200@60Hz (RB)", XVIDC_FR_60HZ,
 		{1920, 48, 32, 80, 2080, 1,
-		1200, 3, 6, 26, 1235, 0, 0, 0, 0, 0} },
+		1200, 3, 6, 26, 1235, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1920x1200_75_P, "1920x1200@75Hz", XVIDC_FR_75HZ,
 		{1920, 136, 208, 344, 2608, 0,
 		1200, 3, 6, 46, 1255, 0, 0, 0, 0, 1} },
@@ -396,7 +436,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1200, 3, 6, 53, 1262, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1920x1200_120_P_RB, "1920x1200@120Hz (RB)", XVIDC_FR_120HZ,
 		{1920, 48, 32, 80, 2080, 1,
-		1200, 3, 6, 62, 1271, 0, 0, 0, 0, 0} },
+		1200, 3, 6, 62, 1271, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1920x1440_60_P, "1920x1440@60Hz", XVIDC_FR_60HZ,
 		{1920, 128, 208, 344, 2600, 0,
 		1440, 1, 3, 56, 1500, 0, 0, 0, 0, 1} },
@@ -405,7 +446,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1440, 1, 3, 56, 1500, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_1920x1440_120_P_RB, "1920x1440@120Hz (RB)", XVIDC_FR_120HZ,
 		{1920, 48, 32, 80, 2080, 1,
-		1440, 3, 4, 78, 1525, 0, 0, 0, 0, 0} },
+		1440, 3, 4, 78, 1525, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_1920x2160_60_P, "1920x2160@60Hz", XVIDC_FR_60HZ,
 		{1920, 88, 44, 148, 2200, 1,
 		2160, 20, 10, 60, 2250, 0, 0, 0, 0, 0} },
@@ -450,7 +492,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1600, 3, 6, 49, 1658, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_2560x1600_60_P_RB, "2560x1600@60Hz (RB)", XVIDC_FR_60HZ,
 		{2560, 48, 32, 80, 2720, 1,
-		1600, 3, 6, 37, 1646, 0, 0, 0, 0, 0} },
+		1600, 3, 6, 37, 1646, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_2560x1600_75_P, "2560x1600@75Hz", XVIDC_FR_75HZ,
 		{2560, 208, 280, 488, 3536, 0,
 		1600, 3, 6, 63, 1672, 0, 0, 0, 0, 1} },
@@ -459,7 +502,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		1600, 3, 6, 73, 1682, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_2560x1600_120_P_RB, "2560x1600@120Hz (RB)", XVIDC_FR_120HZ,
 		{2560, 48, 32, 80, 2720, 1,
-		1600, 3, 6, 85, 1694, 0, 0, 0, 0, 0} },
+		1600, 3, 6, 85, 1694, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_3840x2160_24_P, "3840x2160@24Hz", XVIDC_FR_24HZ,
 		{3840, 1276, 88, 296, 5500, 1,
 		2160, 8, 10, 72, 2250, 0, 0, 0, 0, 1} },
@@ -480,7 +524,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		2160, 8, 10, 72, 2250, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_3840x2160_60_P_RB, "3840x2160@60Hz (RB)", XVIDC_FR_60HZ,
 		{3840, 48, 32, 80, 4000, 1,
-		2160, 3, 5, 54, 2222, 0, 0, 0, 0, 0} },
+		2160, 3, 5, 54, 2222, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 	{ XVIDC_VM_4096x2160_24_P, "4096x2160@24Hz", XVIDC_FR_24HZ,
 		{4096, 1020, 88, 296, 5500, 1,
 		2160, 8, 10, 72, 2250, 0, 0, 0, 0, 1} },
@@ -501,7 +546,8 @@ const XVidC_VideoTimingMode XVidC_VideoTimingModes[XVIDC_VM_NUM_SUPPORTED] =
 		2160, 8, 10, 72, 2250, 0, 0, 0, 0, 1} },
 	{ XVIDC_VM_4096x2160_60_P_RB, "4096x2160@60Hz (RB)", XVIDC_FR_60HZ,
 		{4096, 8, 32, 40, 4176, 1,
-		2160, 48, 8, 6, 2222, 0, 0, 0, 0, 0} },
+		2160, 48, 8, 6, 2222, 0, 0, 0, 0, 0},
+		XVIDC_VM_FLAG_RB },
 };
 
 /** @} */
@@ -73,6 +73,42 @@
 static u32 XVphy_DrpAccess(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		XVphy_DirectionType Dir, u16 Addr, u16 *Val);
 
+/*************************** Variable Definitions *****************************/
+
+/* GT adaptors built into the driver, looked up by transceiver type. */
+static const struct {
+	XVphy_GtType XcvrType;
+	const XVphy_GtConfig *GtAdaptor;
+} XVphy_GtAdaptors[] = {
+#ifdef XVPHY_GTXE2_ADAPTOR
+	{XVPHY_GT_TYPE_GTXE2, &Gtxe2Config},
+#endif
+#ifdef XVPHY_GTHE2_ADAPTOR
+	{XVPHY_GT_TYPE_GTHE2, &Gthe2Config},
+#endif
+#ifdef XVPHY_GTPE2_ADAPTOR
+	{XVPHY_GT_TYPE_GTPE2, &Gtpe2Config},
+#endif
+#ifdef XVPHY_GTHE3_ADAPTOR
+	{XVPHY_GT_TYPE_GTHE3, &Gthe3Config},
+#endif
+#ifdef XVPHY_GTHE4_ADAPTOR
+	{XVPHY_GT_TYPE_GTHE4, &Gthe4Config},
+#endif
+#ifdef XVPHY_GTYE4_ADAPTOR
+	{XVPHY_GT_TYPE_GTYE4, &Gtye4Config},
+#endif
+};
+
+/* GT operations, patched to the bound adaptor by XVphy_CfgInitialize(). */
+DEFINE_STATIC_CALL_NULL(XVphy_GtCfgSetCdr, XVphy_GtChOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtCheckPllOpRange, XVphy_GtPllOpRangeOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtOutDivChReconfig, XVphy_GtOutDivOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtClkChReconfig, XVphy_GtChOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtClkCmnReconfig, XVphy_GtChOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtRxChReconfig, XVphy_GtChOp);
+DEFINE_STATIC_CALL_NULL(XVphy_GtTxChReconfig, XVphy_GtChOp);
+
 /**************************** Function Definitions ****************************/
 
 /******************************************************************************/
@@ -109,19 +145,23 @@ void XVphy_CfgInitialize(XVphy *InstancePtr, XVphy_Config *ConfigPtr,
 	InstancePtr->Config = *ConfigPtr;
 	InstancePtr->Config.BaseAddr = EffectiveAddr;
 
-#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
-	InstancePtr->GtAdaptor = &Gtxe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE2)
-	InstancePtr->GtAdaptor = &Gthe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTPE2)
-	InstancePtr->GtAdaptor = &Gtpe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE3)
-	InstancePtr->GtAdaptor = &Gthe3Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4)
-	InstancePtr->GtAdaptor = &Gthe4Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTYE4)
-	InstancePtr->GtAdaptor = &Gtye4Config;
-#endif
+	/* Bind the GT adaptor of the configured transceiver type. */
+	InstancePtr->GtAdaptor = XVphy_GtAdaptorLookup(ConfigPtr->XcvrType);
+	Xil_AssertVoid(InstancePtr->GtAdaptor != NULL);
+	static_call_update(XVphy_GtCfgSetCdr,
+			InstancePtr->GtAdaptor->CfgSetCdr);
+	static_call_update(XVphy_GtCheckPllOpRange,
+			InstancePtr->GtAdaptor->CheckPllOpRange);
+	static_call_update(XVphy_GtOutDivChReconfig,
+			InstancePtr->GtAdaptor->OutDivChReconfig);
+	static_call_update(XVphy_GtClkChReconfig,
+			InstancePtr->GtAdaptor->ClkChReconfig);
+	static_call_update(XVphy_GtClkCmnReconfig,
+			InstancePtr->GtAdaptor->ClkCmnReconfig);
+	static_call_update(XVphy_GtRxChReconfig,
+			InstancePtr->GtAdaptor->RxChReconfig);
+	static_call_update(XVphy_GtTxChReconfig,
+			InstancePtr->GtAdaptor->TxChReconfig);
 
 	const XVphy_SysClkDataSelType SysClkCfg[7][2] = {
 		{(XVphy_SysClkDataSelType)0, XVPHY_SYSCLKSELDATA_TYPE_CPLL_OUTCLK},
@@ -170,6 +210,31 @@ void XVphy_CfgInitialize(XVphy *InstancePtr, XVphy_Config *ConfigPtr,
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
 }
 
+/******************************************************************************/
+/**
+ * This function returns the GT adaptor for a transceiver type.
+ *
+ * @param	XcvrType is the transceiver type of the Video PHY instance.
+ *
+ * @return	A pointer to the GT adaptor, or NULL if no adaptor for the
+ *		transceiver type is built into the driver.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+const XVphy_GtConfig *XVphy_GtAdaptorLookup(XVphy_GtType XcvrType)
+{
+	u8 Idx;
+
+	for (Idx = 0; Idx < ARRAY_SIZE(XVphy_GtAdaptors); Idx++) {
+		if (XVphy_GtAdaptors[Idx].XcvrType == XcvrType) {
+			return XVphy_GtAdaptors[Idx].GtAdaptor;
+		}
+	}
+
+	return NULL;
+}
+
 /*****************************************************************************/
 /**
 * This function will initialize the PLL selection for a given channel.
@@ -421,6 +486,10 @@ u32 XVphy_CfgQuadRefClkFreq(XVphy *InstancePtr, u8 QuadId,
 	//	xil_printf("RefClkType is greater \n\r");
 		return XST_FAILURE;
 	}
+	if (InstancePtr->Quads[QuadId].RefClkHz[RefClkIndex] != FreqHz) {
+		/* Index the PLL divider solutions for the new frequency. */
+		XVphy_PllIndexBuild(InstancePtr, QuadId, FreqHz);
+	}
 	InstancePtr->Quads[QuadId].RefClkHz[RefClkIndex] = FreqHz;
 //	xil_printf("RefClkIndex=%d QuadId=%d FreqHz=%d \n\r",RefClkIndex,QuadId,FreqHz);
 	return XST_SUCCESS;
@@ -1672,19 +1741,20 @@ void XVphy_RegisterDebug(XVphy *InstancePtr)
 		RegOffset += 4;
 	}
 
-#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
-	MaxDrpAddr = 0x0044;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE2)
-	MaxDrpAddr = 0x0047;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTPE2)
-	MaxDrpAddr = 0x002D;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE3)
-	MaxDrpAddr = 0x00B0;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4)
-	MaxDrpAddr = 0x00B0;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTYE4)
-	MaxDrpAddr = 0x00B0;
-#endif
+	switch (InstancePtr->Config.XcvrType) {
+	case XVPHY_GT_TYPE_GTXE2:
+		MaxDrpAddr = 0x0044;
+		break;
+	case XVPHY_GT_TYPE_GTHE2:
+		MaxDrpAddr = 0x0047;
+		break;
+	case XVPHY_GT_TYPE_GTPE2:
+		MaxDrpAddr = 0x002D;
+		break;
+	default:
+		MaxDrpAddr = 0x00B0;
+		break;
+	}
 
 	xil_printf("\r\nVPHY GT COMMON DRP Registers\r\n");
 	xil_printf("----------------------------\r\n");
@@ -1702,19 +1772,26 @@ void XVphy_RegisterDebug(XVphy *InstancePtr)
 		xil_printf("No QPLL in this VPHY Instance\r\n");
 	}
 
-#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
-	MaxDrpAddr = 0x015C;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE2)
-	MaxDrpAddr = 0x015E;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTPE2)
-	MaxDrpAddr = 0x00AD;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE3)
-	MaxDrpAddr = 0x015F;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4)
-	MaxDrpAddr = 0x025F;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTYE4)
-	MaxDrpAddr = 0x028C;
-#endif
+	switch (InstancePtr->Config.XcvrType) {
+	case XVPHY_GT_TYPE_GTXE2:
+		MaxDrpAddr = 0x015C;
+		break;
+	case XVPHY_GT_TYPE_GTHE2:
+		MaxDrpAddr = 0x015E;
+		break;
+	case XVPHY_GT_TYPE_GTPE2:
+		MaxDrpAddr = 0x00AD;
+		break;
+	case XVPHY_GT_TYPE_GTHE3:
+		MaxDrpAddr = 0x015F;
+		break;
+	case XVPHY_GT_TYPE_GTYE4:
+		MaxDrpAddr = 0x028C;
+		break;
+	default:
+		MaxDrpAddr = 0x025F;
+		break;
+	}
 	/* Get Max number of channels in VPHY */
 	MaxChannels = (InstancePtr->Config.RxChannels >
 					InstancePtr->Config.TxChannels) ?
@@ -464,6 +464,9 @@ typedef struct {
 	};
 	u16 Cdr[5];
 	u8 IsLowerBand;
+	u8 SdmEnable;		/**< QPLL fractional-N feedback mode. */
+	u32 SdmData;		/**< Fractional part of the QPLL feedback
+					divider, in units of 2^-24. */
 } XVphy_PllParam;
 
 /**
@@ -931,6 +934,10 @@ u32 XVphy_ClkDetGetRefClkFreqHz(XVphy *InstancePtr, XVphy_DirectionType Dir);
 u32 XVphy_DruGetRefClkFreqHz(XVphy *InstancePtr);
 void XVphy_HdmiDebugInfo(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
 void XVphy_DpDebugInfo(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
+u32 XVphy_DpGetStreamBitsPerPixelX2(XVidC_ColorFormat ColorFormatId,
+		XVidC_ColorDepth Bpc);
+u32 XVphy_DpPlanLink(const XVidC_VideoStream *Stream, u64 PixelClkHz,
+		const XVphy_DpLinkCaps *Caps, XVphy_DpLinkPlan *PlanPtr);
 void XVphy_SetHdmiCallback(XVphy *InstancePtr,
 		XVphy_HdmiHandlerType HandlerType,
 		void *CallbackFunc, void *CallbackRef);
@@ -364,4 +364,152 @@ void XVphy_DpDebugInfo(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 
 	print(" \r\n");
 }
+
+/*****************************************************************************/
+/**
+* This function returns the number of bits a pixel occupies on a DP main link,
+* in units of half a bit so that 4:2:0 needs no fractions.
+*
+* @param	ColorFormatId is the color format of the stream.
+* @param	Bpc is the number of bits per color component.
+*
+* @return	Twice the bits per pixel, or 0 if the format cannot be
+*		transported over DP.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XVphy_DpGetStreamBitsPerPixelX2(XVidC_ColorFormat ColorFormatId,
+		XVidC_ColorDepth Bpc)
+{
+	switch (Bpc) {
+	case XVIDC_BPC_6:
+	case XVIDC_BPC_8:
+	case XVIDC_BPC_10:
+	case XVIDC_BPC_12:
+	case XVIDC_BPC_16:
+		break;
+	default:
+		return 0;
+	}
+
+	switch (ColorFormatId) {
+	case XVIDC_CSF_RGB:
+	case XVIDC_CSF_YCRCB_444:
+		return 6 * Bpc;
+	case XVIDC_CSF_YCRCB_422:
+	case XVIDC_CSF_YCBCR_422:
+		return 4 * Bpc;
+	case XVIDC_CSF_YCRCB_420:
+	case XVIDC_CSF_YCBCR_420:
+		return 3 * Bpc;
+	case XVIDC_CSF_YONLY:
+		return 2 * Bpc;
+	default:
+		return 0;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function finds the smallest DP link that carries a video stream.
+*
+* Every combination of the offered line rates and of 1, 2 or 4 lanes is
+* checked against the stream payload. The payload capacity of a lane is its
+* line rate less the 8b/10b coding overhead. An SST stream must fit in the
+* capacity left by the worst case down-spread; an MST stream must fit, with
+* the PBN margin, in the 63 MTP time slots that are not the MTP header.
+*
+* @param	Stream is the video stream to carry. Its color format and
+*		color depth are used, and its timing when PixelClkHz is 0.
+* @param	PixelClkHz is the pixel clock of the stream, or 0 to derive it
+*		from the stream timing and frame rate.
+* @param	Caps describes the line rates and lanes available.
+* @param	PlanPtr is filled with the chosen link.
+*
+* @return
+*		- XST_SUCCESS if a link was found.
+*		- XST_FAILURE if the stream is invalid or does not fit.
+*
+* @note		Of the links that fit, the one with the least payload capacity
+*		wins, and fewer lanes break a tie. Both lower the power drawn
+*		and shorten link training.
+*
+******************************************************************************/
+u32 XVphy_DpPlanLink(const XVidC_VideoStream *Stream, u64 PixelClkHz,
+		const XVphy_DpLinkCaps *Caps, XVphy_DpLinkPlan *PlanPtr)
+{
+	u64 StreamBps;
+	u64 CapacityBps;
+	u64 NeedNum;
+	u64 NeedDen;
+	u32 BppX2;
+	u8 LaneCount;
+	u8 Found = FALSE;
+	u8 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(Stream != NULL);
+	Xil_AssertNonvoid(Caps != NULL);
+	Xil_AssertNonvoid(PlanPtr != NULL);
+
+	BppX2 = XVphy_DpGetStreamBitsPerPixelX2(Stream->ColorFormatId,
+			Stream->ColorDepth);
+	if (BppX2 == 0) {
+		return XST_FAILURE;
+	}
+
+	if (PixelClkHz == 0) {
+		/* Round up, a link sized for the stream must not fall short. */
+		PixelClkHz = (XVidC_GetPixelClockMilliHzByStream(Stream) +
+				999) / 1000;
+	}
+	if (PixelClkHz == 0) {
+		return XST_FAILURE;
+	}
+
+	StreamBps = PixelClkHz * BppX2 / 2;
+
+	/* A link fits when StreamBps * NeedNum <= CapacityBps * NeedDen. */
+	if (Caps->IsMst) {
+		NeedNum = XVPHY_DP_MST_PBN_MARGIN_NUM *
+			XVPHY_DP_MST_SLOTS_DEN;
+		NeedDen = XVPHY_DP_MST_PBN_MARGIN_DEN *
+			XVPHY_DP_MST_SLOTS_NUM;
+	}
+	else {
+		NeedNum = XVPHY_DP_SST_MARGIN_DEN;
+		NeedDen = XVPHY_DP_SST_MARGIN_NUM;
+	}
+
+	for (Index = 0; Index < Caps->NumLinkRates; Index++) {
+		for (LaneCount = 1; (LaneCount <= Caps->MaxLaneCount) &&
+				(LaneCount <= XVPHY_DP_MAX_LANE_COUNT);
+				LaneCount <<= 1) {
+			CapacityBps = Caps->LinkRatesHz[Index] * LaneCount *
+				XVPHY_DP_8B10B_NUM / XVPHY_DP_8B10B_DEN;
+			if ((StreamBps * NeedNum) > (CapacityBps * NeedDen)) {
+				continue;
+			}
+			if (Found && ((CapacityBps > PlanPtr->CapacityBps) ||
+					((CapacityBps == PlanPtr->CapacityBps) &&
+					 (LaneCount >= PlanPtr->LaneCount)))) {
+				continue;
+			}
+
+			PlanPtr->LinkRateHz = Caps->LinkRatesHz[Index];
+			PlanPtr->LaneCount = LaneCount;
+			PlanPtr->CapacityBps = CapacityBps;
+			Found = TRUE;
+		}
+	}
+
+	if (!Found) {
+		return XST_FAILURE;
+	}
+
+	PlanPtr->StreamBps = StreamBps * NeedNum / NeedDen;
+
+	return XST_SUCCESS;
+}
 #endif
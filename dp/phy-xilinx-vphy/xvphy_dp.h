@@ -69,5 +69,44 @@
 #define XVPHY_DP_REF_CLK_FREQ_HZ_81	  81000000LL
 #define XVPHY_DP_REF_CLK_FREQ_HZ_270	 270000000LL
 
+/* Link bandwidth planning. */
+#define XVPHY_DP_MAX_LANE_COUNT		4
+/* 8b/10b channel coding carries 8 payload bits per 10 line bits. */
+#define XVPHY_DP_8B10B_NUM		8
+#define XVPHY_DP_8B10B_DEN		10
+/* SST: up to 0.5% down-spread lowers the average link symbol clock. */
+#define XVPHY_DP_SST_MARGIN_NUM		995
+#define XVPHY_DP_SST_MARGIN_DEN		1000
+/* MST: one of the 64 MTP time slots carries the MTP header, and the
+ * stream is rounded up by the 0.6% PBN margin. */
+#define XVPHY_DP_MST_SLOTS_NUM		63
+#define XVPHY_DP_MST_SLOTS_DEN		64
+#define XVPHY_DP_MST_PBN_MARGIN_NUM	1006
+#define XVPHY_DP_MST_PBN_MARGIN_DEN	1000
+
+/**************************** Type Definitions ********************************/
+
+/**
+ * This typedef describes what the PHY and the sink can offer to a DP link.
+ */
+typedef struct {
+	const u64 *LinkRatesHz;		/**< Line rates the link can run at. */
+	u8 NumLinkRates;		/**< Number of entries in LinkRatesHz. */
+	u8 MaxLaneCount;		/**< Maximum number of lanes (1, 2 or
+						4). */
+	u8 IsMst;			/**< Stream is carried in MST MTPs. */
+} XVphy_DpLinkCaps;
+
+/**
+ * This typedef contains the link configuration chosen for a video stream.
+ */
+typedef struct {
+	u64 LinkRateHz;			/**< Line rate per lane. */
+	u8 LaneCount;			/**< Number of lanes. */
+	u64 StreamBps;			/**< Stream payload including the
+						SST/MST margins. */
+	u64 CapacityBps;		/**< Payload capacity of the link. */
+} XVphy_DpLinkPlan;
+
 #endif /* XVPHY_HDMI_H_ */
 /** @} */
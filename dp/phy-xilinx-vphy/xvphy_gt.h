@@ -37,10 +37,33 @@
 
 /******************************* Include Files ********************************/
 
+#include <linux/static_call.h>
 #include "xvphy.h"
 #include "xvphy_i.h"
 #include "xil_assert.h"
 
+/************************** Constant Definitions *****************************/
+
+/*
+ * GT adaptors built into the driver, selected per instance at run time from
+ * the configured transceiver type. XVPHY_<GT>_ADAPTOR may be set by the
+ * build for each adaptor to include; the XPAR_VPHY_0_TRANSCEIVER one is
+ * always included.
+ */
+#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2) && !defined(XVPHY_GTXE2_ADAPTOR)
+#define XVPHY_GTXE2_ADAPTOR
+#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE2) && !defined(XVPHY_GTHE2_ADAPTOR)
+#define XVPHY_GTHE2_ADAPTOR
+#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTPE2) && !defined(XVPHY_GTPE2_ADAPTOR)
+#define XVPHY_GTPE2_ADAPTOR
+#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE3) && !defined(XVPHY_GTHE3_ADAPTOR)
+#define XVPHY_GTHE3_ADAPTOR
+#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4) && !defined(XVPHY_GTHE4_ADAPTOR)
+#define XVPHY_GTHE4_ADAPTOR
+#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTYE4) && !defined(XVPHY_GTYE4_ADAPTOR)
+#define XVPHY_GTYE4_ADAPTOR
+#endif
+
 /****************************** Type Definitions ******************************/
 
 typedef struct {
@@ -50,6 +73,12 @@ typedef struct {
 	const u8 *D;
 } XVphy_GtPllDivs;
 
+/* Types of the GT adaptor operations. */
+typedef u32 XVphy_GtChOp(XVphy *, u8, XVphy_ChannelId);
+typedef u32 XVphy_GtPllOpRangeOp(XVphy *, u8, XVphy_ChannelId, u64);
+typedef u32 XVphy_GtOutDivOp(XVphy *, u8, XVphy_ChannelId,
+		XVphy_DirectionType);
+
 typedef struct XVphy_GtConfigS {
 	u32 (*CfgSetCdr)(XVphy *, u8, XVphy_ChannelId);
 	u32 (*CheckPllOpRange)(XVphy *, u8, XVphy_ChannelId, u64);
@@ -76,37 +105,75 @@ u32 XVphy_ClkCmnReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
 u32 XVphy_RxChReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
 u32 XVphy_TxChReconfig(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
 #else
+/* The GT operations are static calls, patched to the adaptor bound by
+ * XVphy_CfgInitialize(), so they do not pay for an indirect branch. The
+ * driver supports a single Video PHY instance (XPAR_XVPHY_NUM_INSTANCES). */
+#define XVPHY_GT_CALL(Ip, Op, ...) \
+		static_call(XVphy_Gt##Op)(Ip, __VA_ARGS__)
 #define XVphy_CfgSetCdr(Ip, ...) \
-		((Ip)->GtAdaptor->CfgSetCdr(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, CfgSetCdr, __VA_ARGS__)
 #define XVphy_CheckPllOpRange(Ip, ...) \
-		((Ip)->GtAdaptor->CheckPllOpRange(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, CheckPllOpRange, __VA_ARGS__)
 #define XVphy_OutDivChReconfig(Ip, ...) \
-		((Ip)->GtAdaptor->OutDivChReconfig(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, OutDivChReconfig, __VA_ARGS__)
 #define XVphy_ClkChReconfig(Ip, ...) \
-		((Ip)->GtAdaptor->ClkChReconfig(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, ClkChReconfig, __VA_ARGS__)
 #define XVphy_ClkCmnReconfig(Ip, ...) \
-		((Ip)->GtAdaptor->ClkCmnReconfig(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, ClkCmnReconfig, __VA_ARGS__)
 #define XVphy_RxChReconfig(Ip, ...) \
-		((Ip)->GtAdaptor->RxChReconfig(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, RxChReconfig, __VA_ARGS__)
 #define XVphy_TxChReconfig(Ip, ...) \
-		((Ip)->GtAdaptor->TxChReconfig(Ip, __VA_ARGS__))
+		XVPHY_GT_CALL(Ip, TxChReconfig, __VA_ARGS__)
 #endif
 
 /*************************** Variable Declarations ****************************/
 
-#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTXE2)
+DECLARE_STATIC_CALL(XVphy_GtCfgSetCdr, XVphy_GtChOp);
+DECLARE_STATIC_CALL(XVphy_GtCheckPllOpRange, XVphy_GtPllOpRangeOp);
+DECLARE_STATIC_CALL(XVphy_GtOutDivChReconfig, XVphy_GtOutDivOp);
+DECLARE_STATIC_CALL(XVphy_GtClkChReconfig, XVphy_GtChOp);
+DECLARE_STATIC_CALL(XVphy_GtClkCmnReconfig, XVphy_GtChOp);
+DECLARE_STATIC_CALL(XVphy_GtRxChReconfig, XVphy_GtChOp);
+DECLARE_STATIC_CALL(XVphy_GtTxChReconfig, XVphy_GtChOp);
+
+#ifdef XVPHY_GTXE2_ADAPTOR
 extern const XVphy_GtConfig Gtxe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE2)
+#endif
+#ifdef XVPHY_GTHE2_ADAPTOR
 extern const XVphy_GtConfig Gthe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTPE2)
+#endif
+#ifdef XVPHY_GTPE2_ADAPTOR
 extern const XVphy_GtConfig Gtpe2Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE3)
+#endif
+#ifdef XVPHY_GTHE3_ADAPTOR
 extern const XVphy_GtConfig Gthe3Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4)
+#endif
+#ifdef XVPHY_GTHE4_ADAPTOR
 extern const XVphy_GtConfig Gthe4Config;
-#elif (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTYE4)
+#endif
+#ifdef XVPHY_GTYE4_ADAPTOR
 extern const XVphy_GtConfig Gtye4Config;
 #endif
 
+/**************************** Function Prototypes *****************************/
+
+const XVphy_GtConfig *XVphy_GtAdaptorLookup(XVphy_GtType XcvrType);
+
+#ifdef XVPHY_GTHE4_ADAPTOR
+u32 XVphy_Gthe4CfgSetCdr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId);
+u32 XVphy_Gthe4CheckPllOpRange(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId ChId, u64 PllClkOutFreqHz);
+u32 XVphy_Gthe4OutDivChReconfig(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId ChId, XVphy_DirectionType Dir);
+u32 XVphy_Gthe4ClkChReconfig(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId ChId);
+u32 XVphy_Gthe4ClkCmnReconfig(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId CmnId);
+u32 XVphy_Gthe4RxChReconfig(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId ChId);
+u32 XVphy_Gthe4TxChReconfig(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId ChId);
+#endif
+
 #endif /* XVPHY_GT_H_ */
 /** @} */
@@ -50,7 +50,7 @@
 
 //#include "xparameters.h"
 #include "xvphy_gt.h"
-#if (XPAR_VPHY_0_TRANSCEIVER == XVPHY_GTHE4)
+#ifdef XVPHY_GTHE4_ADAPTOR
 #include "xstatus.h"
 
 /**************************** Function Prototypes *****************************/
@@ -102,6 +102,12 @@ u32 XVphy_Gthe4RxPllRefClkDiv1Reconfig(XVphy *InstancePtr, u8 QuadId,
 #define XVPHY_DRP_TXOUT_DIV		0x7C
 #define XVPHY_DRP_QPLL1_FBDIV		0x94
 #define XVPHY_DRP_QPLL1_REFCLK_DIV	0x98
+#define XVPHY_DRP_SDM0DATA1_0		0x24
+#define XVPHY_DRP_SDM0DATA1_1		0x25
+#define XVPHY_DRP_SDM1DATA1_0		0xA4
+#define XVPHY_DRP_SDM1DATA1_1		0xA5
+#define XVPHY_DRP_SDMDATA1_1_MASK	0x01FF
+#define XVPHY_DRP_SDM_DATA_PIN_SEL	0x2000
 #define XVPHY_DRP_RXCDR_CFG_WORD0	0x0E
 #define XVPHY_DRP_RXCDR_CFG_WORD1	0x0F
 #define XVPHY_DRP_RXCDR_CFG_WORD2	0x10
@@ -172,7 +178,6 @@ u32 XVphy_Gthe4CfgSetCdr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 {
 	XVphy_Channel *ChPtr;
 	u32 Status = XST_SUCCESS;
-	u64 LineRateHz;
 
 	/* Set CDR values only for CPLLs. */
 	if ((ChId < XVPHY_CHANNEL_ID_CH1) || (ChId > XVPHY_CHANNEL_ID_CH4)) {
@@ -187,13 +192,14 @@ u32 XVphy_Gthe4CfgSetCdr(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId)
 	ChPtr->PllParams.Cdr[3] = 0x0000;
 	ChPtr->PllParams.Cdr[4] = 0x0000;
 	if (InstancePtr->Config.RxProtocol == XVPHY_PROTOCOL_DP) {
-		LineRateHz = XVphy_GetLineRateHz(InstancePtr, QuadId, ChId);
-
-		if(LineRateHz==XVPHY_DP_LINK_RATE_HZ_810GBPS) {
-		  ChPtr->PllParams.Cdr[2] = 0x01C4;
-		} else if(LineRateHz==XVPHY_DP_LINK_RATE_HZ_540GBPS) {
+		/* The setting follows the RX output divider, so eDP
+		 * intermediate rates need no entries of their own:
+		 * RxOutDiv = 1 (5.4, 8.1G)  => Cdr[2] = 0x01C4
+		 * RxOutDiv = 2 (2.7G)       => Cdr[2] = 0x01B4
+		 * RxOutDiv = 4 (1.62G)      => Cdr[2] = 0x01A3 */
+		if(ChPtr->RxOutDiv==1) {
 			ChPtr->PllParams.Cdr[2] = 0x01C4;
-		} else if(LineRateHz==XVPHY_DP_LINK_RATE_HZ_270GBPS) {
+		} else if(ChPtr->RxOutDiv==2) {
 			ChPtr->PllParams.Cdr[2] = 0x01B4;
 		} else {
 			ChPtr->PllParams.Cdr[2] = 0x01A3;
@@ -427,6 +433,7 @@ u32 XVphy_Gthe4ClkCmnReconfig(XVphy *InstancePtr, u8 QuadId,
 	u16 WriteVal;
 	u32 QpllxVcoRateMHz;
 	u32 QpllxClkOutMHz;
+	u32 SdmData;
     u32 Status = XST_SUCCESS;
 
 	/* Obtain current DRP register value for QPLLx_FBDIV. */
@@ -455,6 +462,26 @@ u32 XVphy_Gthe4ClkCmnReconfig(XVphy *InstancePtr, u8 QuadId,
 	Status |= XVphy_DrpWr(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN,
 			(CmnId == XVPHY_CHANNEL_ID_CMN0) ? 0x18 : 0x98, DrpVal);
 
+	/* Set the QPLLx sigma-delta modulator fraction from the attributes
+	 * rather than the SDMxDATA ports; zero for integer-N operation. */
+	SdmData = InstancePtr->Quads[QuadId].Plls[XVPHY_CH2IDX(CmnId)].
+			PllParams.SdmEnable ?
+		InstancePtr->Quads[QuadId].Plls[XVPHY_CH2IDX(CmnId)].
+			PllParams.SdmData : 0;
+	Status |= XVphy_DrpWr(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN,
+			(CmnId == XVPHY_CHANNEL_ID_CMN0) ?
+			XVPHY_DRP_SDM0DATA1_0 : XVPHY_DRP_SDM1DATA1_0,
+			(u16)(SdmData & 0xFFFF));
+	Status |= XVphy_DrpRd(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN,
+			(CmnId == XVPHY_CHANNEL_ID_CMN0) ?
+			XVPHY_DRP_SDM0DATA1_1 : XVPHY_DRP_SDM1DATA1_1, &DrpVal);
+	DrpVal &= ~XVPHY_DRP_SDMDATA1_1_MASK;
+	DrpVal |= (SdmData >> 16) & XVPHY_DRP_SDMDATA1_1_MASK;
+	DrpVal &= ~XVPHY_DRP_SDM_DATA_PIN_SEL;
+	Status |= XVphy_DrpWr(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN,
+			(CmnId == XVPHY_CHANNEL_ID_CMN0) ?
+			XVPHY_DRP_SDM0DATA1_1 : XVPHY_DRP_SDM1DATA1_1, DrpVal);
+
 	if ((InstancePtr->Config.TxProtocol == XVPHY_PROTOCOL_HDMI) ||
 		(InstancePtr->Config.RxProtocol == XVPHY_PROTOCOL_HDMI)) {
 
@@ -1199,10 +1199,10 @@ u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
 		u32 PllClkInFreqHz)
 {
 	u32 Status;
-	u64 PllClkOutFreqHz;
-	u64 CalcLineRateFreqHz;
+	XVphy_PllSolution Sol;
 	u8 Id, Id0, Id1;
 	u64 PllClkInFreqHzIn = PllClkInFreqHz;
+	u64 CurVcoHz = 0;
 	XVphy_Channel *PllPtr = &InstancePtr->Quads[QuadId].
 		Plls[XVPHY_CH2IDX(ChId)];
 
@@ -1211,51 +1211,34 @@ u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
 					PllPtr->PllRefClkSel);
 	}
 
-	/* Select PLL value table offsets. */
-	const XVphy_GtPllDivs *GtPllDivs;
-	if (XVPHY_ISCH(ChId)) {
-		GtPllDivs = &InstancePtr->GtAdaptor->CpllDivs;
-	}
-	else {
-		GtPllDivs = &InstancePtr->GtAdaptor->QpllDivs;
-	}
-
-	const u8 *M, *N1, *N2, *D;
-	for (N2 = GtPllDivs->N2; *N2 != 0; N2++) {
-	for (N1 = GtPllDivs->N1; *N1 != 0; N1++) {
-	for (M = GtPllDivs->M;   *M != 0;  M++) {
-		PllClkOutFreqHz = (PllClkInFreqHzIn * *N1 * *N2) / *M;
-
-		/* Test if the calculated PLL clock is in the VCO range. */
-		Status = XVphy_CheckPllOpRange(InstancePtr, QuadId, ChId,
-				PllClkOutFreqHz);
-		if (Status != XST_SUCCESS) {
-			continue;
-		}
-
-		if ((InstancePtr->Config.XcvrType == XVPHY_GT_TYPE_GTPE2) ||
-				(XVPHY_ISCH(ChId))) {
-			PllClkOutFreqHz *= 2;
-		}
-		/* Apply TX/RX divisor. */
-		for (D = GtPllDivs->D; *D != 0; D++) {
-			CalcLineRateFreqHz = PllClkOutFreqHz / *D;
-			if (CalcLineRateFreqHz == PllPtr->LineRateHz) {
-				goto calc_done;
-			}
+	/* Current VCO frequency, for a policy that keeps it unchanged. */
+	if (PllPtr->PllParams.MRefClkDiv) {
+		CurVcoHz = (PllClkInFreqHzIn * PllPtr->PllParams.N1FbDiv *
+				PllPtr->PllParams.N2FbDiv) /
+				PllPtr->PllParams.MRefClkDiv;
+		if (PllPtr->PllParams.SdmEnable) {
+			CurVcoHz += ((PllClkInFreqHzIn *
+				PllPtr->PllParams.SdmData) >>
+				XVPHY_QPLL_SDM_WIDTH) /
+				PllPtr->PllParams.MRefClkDiv;
 		}
 	}
+
+	/* Resolve the divider values, integer-N first, then fractional-N. */
+	Status = XVphy_PllSolve(InstancePtr, QuadId, ChId,
+			PllClkInFreqHzIn, PllPtr->LineRateHz, CurVcoHz, &Sol);
+	if (Status != XST_SUCCESS) {
+		/* Calculation failed, don't change divisor settings. */
+		return XST_FAILURE;
 	}
-	}
-	/* Calculation failed, don't change divisor settings. */
-	return XST_FAILURE;
 
-calc_done:
 	/* Found the multiplier and divisor values for requested line rate. */
-	PllPtr->PllParams.MRefClkDiv = *M;
-	PllPtr->PllParams.NFbDiv = *N1;
-	PllPtr->PllParams.N2FbDiv = *N2; /* Won't be used for QPLL.*/
+	PllPtr->PllParams.MRefClkDiv = Sol.M;
+	PllPtr->PllParams.NFbDiv = Sol.N1;
+	PllPtr->PllParams.N2FbDiv = Sol.N2; /* Won't be used for QPLL.*/
 	PllPtr->PllParams.IsLowerBand = 1; /* Won't be used for CPLL. */
+	PllPtr->PllParams.SdmEnable = Sol.SdmEnable; /* QPLL only. */
+	PllPtr->PllParams.SdmData = Sol.SdmData;
 
 	if (XVPHY_ISCMN(ChId)) {
 		/* Same divisor value for all channels if using a QPLL. */
@@ -1265,7 +1248,7 @@ calc_done:
 	XVphy_Ch2Ids(InstancePtr, ChId, &Id0, &Id1);
 	for (Id = Id0; Id <= Id1; Id++) {
 		InstancePtr->Quads[QuadId].Plls[XVPHY_CH2IDX(Id)].OutDiv[Dir] =
-			*D;
+			Sol.D;
 		if (Dir == XVPHY_DIR_RX) {
 			XVphy_CfgSetCdr(InstancePtr, QuadId, (XVphy_ChannelId)Id);
 		}
@@ -1331,6 +1314,12 @@ u64 XVphy_GetPllVcoFreqHz(XVphy *InstancePtr, u8 QuadId,
 				InstancePtr->Quads[QuadId].Plls[XVPHY_CH2IDX(ChId)].
 								PllParams.MRefClkDiv;
 
+	/* Add the fractional part of a QPLL in fractional-N mode. */
+	if (PllPtr->PllParams.SdmEnable) {
+		PllxVcoRateHz += ((PllRefClkHz * PllPtr->PllParams.SdmData) >>
+				XVPHY_QPLL_SDM_WIDTH) / PllPtr->PllParams.MRefClkDiv;
+	}
+
 	return PllxVcoRateHz;
 }
 
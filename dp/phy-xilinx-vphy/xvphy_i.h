@@ -43,8 +43,43 @@
 #include "xvidc.h"
 #include "xvphy_dp.h"
 
+/************************** Constant Definitions *****************************/
+
+/* Number of fractional bits of the QPLL sigma-delta modulator data. */
+#define XVPHY_QPLL_SDM_WIDTH	24
+
 /****************************** Type Definitions ******************************/
 
+/**
+ * This typedef enumerates the policies for choosing among the PLL divider
+ * solutions that produce the same line rate.
+ */
+typedef enum {
+	XVPHY_PLL_POLICY_FIRST = 0,	/**< First in divider table order. */
+	XVPHY_PLL_POLICY_LOW_VCO,	/**< Lowest VCO frequency (power). */
+	XVPHY_PLL_POLICY_LOW_M,		/**< Lowest reference clock divider
+					  *  (phase noise). */
+	XVPHY_PLL_POLICY_SAME_VCO,	/**< Current VCO frequency, so only
+					  *  the output divider changes;
+					  *  lowest VCO otherwise. */
+	XVPHY_PLL_POLICY_NUM,
+} XVphy_PllPolicy;
+
+/**
+ * This typedef contains one set of PLL divider values and the line rate it
+ * produces from a given reference clock.
+ */
+typedef struct {
+	u64 LineRateHz;		/**< Resulting line rate. */
+	u64 VcoHz;		/**< PLL VCO frequency. */
+	u16 Order;		/**< Position in divider table enumeration. */
+	u8 M;			/**< Reference clock divider. */
+	u8 N1;			/**< Feedback divider N1. */
+	u8 N2;			/**< Feedback divider N2 (CPLL only). */
+	u8 D;			/**< TX/RX output divider. */
+	u8 SdmEnable;		/**< Requires QPLL fractional-N mode. */
+	u32 SdmData;		/**< Fractional part of N1 (fractional-N). */
+} XVphy_PllSolution;
 
 /**************************** Function Prototypes *****************************/
 
@@ -57,6 +92,17 @@ u32 XVphy_PllCalculator(XVphy *InstancePtr, u8 QuadId,
 		XVphy_ChannelId ChId, XVphy_DirectionType Dir,
 		u32 PllClkInFreqHz);
 
+/* xvphy_pll.c: PLL divider solution index. */
+u32 XVphy_PllIndexBuild(XVphy *InstancePtr, u8 QuadId, u64 RefClkHz);
+u32 XVphy_PllIndexLookup(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
+		u64 RefClkHz, u64 LineRateHz, u64 CurVcoHz,
+		XVphy_PllSolution *SolPtr);
+u32 XVphy_PllSolve(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
+		u64 RefClkHz, u64 LineRateHz, u64 CurVcoHz,
+		XVphy_PllSolution *SolPtr);
+void XVphy_PllSetPolicy(XVphy_PllPolicy Policy);
+XVphy_PllPolicy XVphy_PllGetPolicy(void);
+
 /* xvphy.c: Voltage swing and preemphasis. */
 void XVphy_SetRxLpm(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
 		XVphy_DirectionType Dir, u8 Enable);
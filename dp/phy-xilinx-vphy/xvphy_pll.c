@@ -0,0 +1,617 @@
+/*******************************************************************************
+* Copyright (C) 2015 - 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: GPL-2.0
+*******************************************************************************/
+/******************************************************************************/
+/**
+ *
+ * @file xvphy_pll.c
+ *
+ * Contains the GT PLL divider solution index used by XVphy_PllCalculator.
+ *
+ * For a given GT adaptor, PLL (CPLL, QPLL0 or QPLL1) and reference clock,
+ * every (M, N1, N2, D) combination of the adaptor's divider tables that
+ * lands in the PLL operating range is enumerated once, sorted by line rate
+ * and hashed, so resolving a line rate to its dividers is a single probe.
+ * Indices are built when a quad reference clock frequency is configured,
+ * or on the first lookup for a reference clock that has not been seen.
+ *
+ * When several divider combinations produce a line rate, the one returned
+ * is chosen by the selected XVphy_PllPolicy: divider table order, lowest
+ * VCO frequency, lowest reference clock divider, or the current VCO
+ * frequency so only the output divider has to change.
+ *
+ * Line rates that no integer divider combination reaches exactly, such as
+ * some eDP intermediate rates, are solved for a GTHE4 QPLL in fractional-N
+ * mode, where the feedback divider takes any value between 16 and 160 plus
+ * a sigma-delta modulator fraction.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+
+/******************************* Include Files ********************************/
+
+#include <linux/hash.h>
+#include <linux/mutex.h>
+#include <linux/printk.h>
+#include <linux/sort.h>
+#include <linux/string.h>
+#include "xstatus.h"
+#include "xvphy.h"
+#include "xvphy_i.h"
+#include "xvphy_gt.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Upper bound of divider combinations of a GT PLL divider table, the GTHE4
+ * QPLL having 360. A larger table is indexed only in part, with a warning.
+ */
+#define XVPHY_PLLIDX_MAX_SOLUTIONS	384
+#define XVPHY_PLLIDX_HASH_BITS		9
+#define XVPHY_PLLIDX_HASH_SIZE		(1 << XVPHY_PLLIDX_HASH_BITS)
+/* CPLL, QPLL0 and QPLL1 indices for two reference clocks. */
+#define XVPHY_PLLIDX_NUM_SLOTS		6
+/* QPLL feedback divider range in fractional-N mode. */
+#define XVPHY_QPLL_SDM_N_MIN		16
+#define XVPHY_QPLL_SDM_N_MAX		160
+
+/****************************** Type Definitions ******************************/
+
+typedef struct {
+	const struct XVphy_GtConfigS *GtAdaptor;
+	XVphy_GtType XcvrType;
+	XVphy_ChannelId PllChId;	/**< CH1 for CPLL, CMN0 or CMN1. */
+	u64 RefClkHz;
+	u16 NumSolutions;
+	u16 Bucket[XVPHY_PLLIDX_HASH_SIZE]; /**< First solution of a line
+						  *  rate plus one, 0 if empty. */
+	XVphy_PllSolution Solutions[XVPHY_PLLIDX_MAX_SOLUTIONS];
+} XVphy_PllIndex;
+
+/*************************** Variable Definitions *****************************/
+
+static XVphy_PllIndex XVphy_PllIndexSlots[XVPHY_PLLIDX_NUM_SLOTS];
+static u8 XVphy_PllIndexNext;
+static XVphy_PllPolicy XVphy_PllPolicySel = XVPHY_PLL_POLICY_FIRST;
+static DEFINE_MUTEX(XVphy_PllIndexLock);
+
+/**************************** Function Definitions ****************************/
+
+/*****************************************************************************/
+/**
+* This function maps a channel ID to the ID identifying its PLL index.
+*
+* @param	ChId is the channel ID the PLL calculation is done for.
+*
+* @return	XVPHY_CHANNEL_ID_CH1 for a CPLL, otherwise the common ID.
+*
+* @note		None.
+*
+******************************************************************************/
+static XVphy_ChannelId XVphy_PllIndexChId(XVphy_ChannelId ChId)
+{
+	if (XVPHY_ISCH(ChId)) {
+		return XVPHY_CHANNEL_ID_CH1;
+	}
+
+	return ChId;
+}
+
+/*****************************************************************************/
+/**
+* This function orders PLL solutions by line rate and, for equal line rates,
+* by the order in which the divider tables enumerate them.
+*
+* @param	A is a pointer to the first solution.
+* @param	B is a pointer to the second solution.
+*
+* @return	Negative, zero or positive as for memcmp.
+*
+* @note		None.
+*
+******************************************************************************/
+static int XVphy_PllSolutionCmp(const void *A, const void *B)
+{
+	const XVphy_PllSolution *SolA = A;
+	const XVphy_PllSolution *SolB = B;
+
+	if (SolA->LineRateHz != SolB->LineRateHz) {
+		return (SolA->LineRateHz < SolB->LineRateHz) ? -1 : 1;
+	}
+
+	return (int)SolA->Order - (int)SolB->Order;
+}
+
+/*****************************************************************************/
+/**
+* This function tells whether a PLL solution is preferred over another one
+* producing the same line rate under the selected policy.
+*
+* @param	SolA is a pointer to the candidate solution.
+* @param	SolB is a pointer to the best solution so far.
+* @param	CurVcoHz is the current VCO frequency of the PLL, 0 if unknown.
+*
+* @return	TRUE if SolA is strictly preferred over SolB, FALSE otherwise.
+*
+* @note		Ties keep SolB, so candidates must be visited in divider
+*		table order. Must be called with XVphy_PllIndexLock held.
+*
+******************************************************************************/
+static u8 XVphy_PllSolutionBetter(const XVphy_PllSolution *SolA,
+		const XVphy_PllSolution *SolB, u64 CurVcoHz)
+{
+	if ((XVphy_PllPolicySel == XVPHY_PLL_POLICY_SAME_VCO) && CurVcoHz &&
+	    ((SolA->VcoHz == CurVcoHz) != (SolB->VcoHz == CurVcoHz))) {
+		return (SolA->VcoHz == CurVcoHz);
+	}
+
+	switch (XVphy_PllPolicySel) {
+	case XVPHY_PLL_POLICY_SAME_VCO:
+	case XVPHY_PLL_POLICY_LOW_VCO:
+		if (SolA->VcoHz != SolB->VcoHz) {
+			return (SolA->VcoHz < SolB->VcoHz);
+		}
+		return (SolA->M < SolB->M);
+	case XVPHY_PLL_POLICY_LOW_M:
+		if (SolA->M != SolB->M) {
+			return (SolA->M < SolB->M);
+		}
+		return (SolA->VcoHz < SolB->VcoHz);
+	default:
+		return FALSE;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function finds the hash bucket of a line rate in a PLL index.
+*
+* @param	IdxPtr is a pointer to the PLL index.
+* @param	LineRateHz is the line rate to look up.
+*
+* @return	The bucket holding the line rate, or the empty bucket where it
+*		would be inserted.
+*
+* @note		None.
+*
+******************************************************************************/
+static u16 *XVphy_PllIndexBucket(XVphy_PllIndex *IdxPtr, u64 LineRateHz)
+{
+	u32 Hash = hash_64(LineRateHz, XVPHY_PLLIDX_HASH_BITS);
+	u16 *BucketPtr;
+
+	for (;;) {
+		BucketPtr = &IdxPtr->Bucket[Hash];
+		if (!*BucketPtr ||
+		    IdxPtr->Solutions[*BucketPtr - 1].LineRateHz == LineRateHz) {
+			return BucketPtr;
+		}
+		Hash = (Hash + 1) & (XVPHY_PLLIDX_HASH_SIZE - 1);
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function counts the entries of a zero terminated divider list.
+*
+* @param	Divs is a pointer to the divider list.
+*
+* @return	The number of dividers in the list.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XVphy_PllDivsCount(const u8 *Divs)
+{
+	u32 Count = 0;
+
+	while (Divs[Count] != 0) {
+		Count++;
+	}
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+* This function enumerates all valid divider combinations of a PLL for a
+* reference clock and builds the line rate index over them.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	IdxPtr is a pointer to the PLL index to fill in.
+* @param	PllChId is XVPHY_CHANNEL_ID_CH1 for the CPLL, or the common ID.
+* @param	RefClkHz is the PLL reference clock frequency.
+*
+* @return	None.
+*
+* @note		Must be called with XVphy_PllIndexLock held.
+*
+******************************************************************************/
+static void XVphy_PllIndexFill(XVphy *InstancePtr, u8 QuadId,
+		XVphy_PllIndex *IdxPtr, XVphy_ChannelId PllChId, u64 RefClkHz)
+{
+	const XVphy_GtPllDivs *GtPllDivs;
+	XVphy_PllSolution *SolPtr;
+	u64 PllClkOutFreqHz;
+	u16 *BucketPtr;
+	u16 Order = 0;
+	u16 Idx;
+
+	const u8 *M, *N1, *N2, *D;
+	u32 NumCombs;
+
+	IdxPtr->GtAdaptor = InstancePtr->GtAdaptor;
+	IdxPtr->XcvrType = InstancePtr->Config.XcvrType;
+	IdxPtr->PllChId = PllChId;
+	IdxPtr->RefClkHz = RefClkHz;
+	IdxPtr->NumSolutions = 0;
+	memset(IdxPtr->Bucket, 0, sizeof(IdxPtr->Bucket));
+
+	if (XVPHY_ISCH(PllChId)) {
+		GtPllDivs = &InstancePtr->GtAdaptor->CpllDivs;
+	}
+	else {
+		GtPllDivs = &InstancePtr->GtAdaptor->QpllDivs;
+	}
+
+	NumCombs = XVphy_PllDivsCount(GtPllDivs->M) *
+			XVphy_PllDivsCount(GtPllDivs->N1) *
+			XVphy_PllDivsCount(GtPllDivs->N2) *
+			XVphy_PllDivsCount(GtPllDivs->D);
+	if (NumCombs > XVPHY_PLLIDX_MAX_SOLUTIONS) {
+		pr_warn("xvphy: %u PLL divider combinations, only %u can be "
+			"indexed, some line rates may not be found\n",
+			NumCombs, XVPHY_PLLIDX_MAX_SOLUTIONS);
+	}
+
+	for (N2 = GtPllDivs->N2; *N2 != 0; N2++) {
+	for (N1 = GtPllDivs->N1; *N1 != 0; N1++) {
+	for (M = GtPllDivs->M;   *M != 0;  M++) {
+		PllClkOutFreqHz = (RefClkHz * *N1 * *N2) / *M;
+
+		/* Test if the calculated PLL clock is in the VCO range. */
+		if (XVphy_CheckPllOpRange(InstancePtr, QuadId, PllChId,
+				PllClkOutFreqHz) != XST_SUCCESS) {
+			continue;
+		}
+
+		if ((InstancePtr->Config.XcvrType == XVPHY_GT_TYPE_GTPE2) ||
+				(XVPHY_ISCH(PllChId))) {
+			PllClkOutFreqHz *= 2;
+		}
+		for (D = GtPllDivs->D; *D != 0; D++) {
+			if (IdxPtr->NumSolutions == XVPHY_PLLIDX_MAX_SOLUTIONS) {
+				break;
+			}
+			SolPtr = &IdxPtr->Solutions[IdxPtr->NumSolutions++];
+			SolPtr->LineRateHz = PllClkOutFreqHz / *D;
+			SolPtr->VcoHz = (RefClkHz * *N1 * *N2) / *M;
+			SolPtr->Order = Order++;
+			SolPtr->M = *M;
+			SolPtr->N1 = *N1;
+			SolPtr->N2 = *N2;
+			SolPtr->D = *D;
+			SolPtr->SdmEnable = 0;
+			SolPtr->SdmData = 0;
+		}
+	}
+	}
+	}
+
+	sort(IdxPtr->Solutions, IdxPtr->NumSolutions,
+			sizeof(XVphy_PllSolution), XVphy_PllSolutionCmp, NULL);
+
+	/* Hash the first solution of every distinct line rate. */
+	for (Idx = 0; Idx < IdxPtr->NumSolutions; Idx++) {
+		if (Idx && (IdxPtr->Solutions[Idx].LineRateHz ==
+				IdxPtr->Solutions[Idx - 1].LineRateHz)) {
+			continue;
+		}
+		BucketPtr = XVphy_PllIndexBucket(IdxPtr,
+				IdxPtr->Solutions[Idx].LineRateHz);
+		*BucketPtr = Idx + 1;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function returns the PLL index for a PLL and reference clock,
+* building it in the least recently created slot if it does not exist.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	PllChId is XVPHY_CHANNEL_ID_CH1 for the CPLL, or the common ID.
+* @param	RefClkHz is the PLL reference clock frequency.
+*
+* @return	A pointer to the PLL index.
+*
+* @note		Must be called with XVphy_PllIndexLock held.
+*
+******************************************************************************/
+static XVphy_PllIndex *XVphy_PllIndexGet(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId PllChId, u64 RefClkHz)
+{
+	XVphy_PllIndex *IdxPtr;
+	u8 Slot;
+
+	for (Slot = 0; Slot < XVPHY_PLLIDX_NUM_SLOTS; Slot++) {
+		IdxPtr = &XVphy_PllIndexSlots[Slot];
+		if ((IdxPtr->GtAdaptor == InstancePtr->GtAdaptor) &&
+		    (IdxPtr->XcvrType == InstancePtr->Config.XcvrType) &&
+		    (IdxPtr->PllChId == PllChId) &&
+		    (IdxPtr->RefClkHz == RefClkHz)) {
+			return IdxPtr;
+		}
+	}
+
+	IdxPtr = &XVphy_PllIndexSlots[XVphy_PllIndexNext];
+	XVphy_PllIndexNext = (XVphy_PllIndexNext + 1) % XVPHY_PLLIDX_NUM_SLOTS;
+	XVphy_PllIndexFill(InstancePtr, QuadId, IdxPtr, PllChId, RefClkHz);
+
+	return IdxPtr;
+}
+
+/*****************************************************************************/
+/**
+* This function builds the PLL solution indices of all PLL types for a
+* reference clock frequency, so later line rate changes only do a lookup.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	RefClkHz is the reference clock frequency.
+*
+* @return
+*		- XST_SUCCESS.
+*
+* @note		Indices that already exist are not rebuilt.
+*
+******************************************************************************/
+u32 XVphy_PllIndexBuild(XVphy *InstancePtr, u8 QuadId, u64 RefClkHz)
+{
+	if (!RefClkHz || !InstancePtr->GtAdaptor) {
+		return XST_SUCCESS;
+	}
+
+	mutex_lock(&XVphy_PllIndexLock);
+	XVphy_PllIndexGet(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CH1, RefClkHz);
+	XVphy_PllIndexGet(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN0, RefClkHz);
+	XVphy_PllIndexGet(InstancePtr, QuadId, XVPHY_CHANNEL_ID_CMN1, RefClkHz);
+	mutex_unlock(&XVphy_PllIndexLock);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function looks up the PLL divider values producing a line rate from
+* a reference clock.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	ChId is the channel ID of the PLL (a channel for the CPLL, or
+*		a common ID for a QPLL).
+* @param	RefClkHz is the PLL reference clock frequency.
+* @param	LineRateHz is the requested line rate.
+* @param	CurVcoHz is the current VCO frequency of the PLL, 0 if unknown.
+* @param	SolPtr is a pointer to the solution to fill in.
+*
+* @return
+*		- XST_SUCCESS if the line rate can be reached exactly.
+*		- XST_FAILURE otherwise.
+*
+* @note		All solutions of the line rate are weighed under the selected
+*		policy. With XVPHY_PLL_POLICY_FIRST the one the divider tables
+*		enumerate first (N2, N1, M, then D order) is returned.
+*
+******************************************************************************/
+u32 XVphy_PllIndexLookup(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
+		u64 RefClkHz, u64 LineRateHz, u64 CurVcoHz,
+		XVphy_PllSolution *SolPtr)
+{
+	XVphy_PllIndex *IdxPtr;
+	const XVphy_PllSolution *BestPtr;
+	u16 *BucketPtr;
+	u16 Idx;
+	u32 Status = XST_FAILURE;
+
+	mutex_lock(&XVphy_PllIndexLock);
+	IdxPtr = XVphy_PllIndexGet(InstancePtr, QuadId,
+			XVphy_PllIndexChId(ChId), RefClkHz);
+	BucketPtr = XVphy_PllIndexBucket(IdxPtr, LineRateHz);
+	if (*BucketPtr) {
+		/* Solutions of a line rate are adjacent, in table order. */
+		BestPtr = &IdxPtr->Solutions[*BucketPtr - 1];
+		for (Idx = *BucketPtr; (Idx < IdxPtr->NumSolutions) &&
+			(IdxPtr->Solutions[Idx].LineRateHz == LineRateHz);
+				Idx++) {
+			if (XVphy_PllSolutionBetter(&IdxPtr->Solutions[Idx],
+					BestPtr, CurVcoHz)) {
+				BestPtr = &IdxPtr->Solutions[Idx];
+			}
+		}
+		*SolPtr = *BestPtr;
+		Status = XST_SUCCESS;
+	}
+	mutex_unlock(&XVphy_PllIndexLock);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function solves the divider values of a QPLL in fractional-N mode for
+* a line rate that has no exact integer solution.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	CmnId is the common channel ID of the QPLL.
+* @param	RefClkHz is the QPLL reference clock frequency.
+* @param	LineRateHz is the requested line rate.
+* @param	CurVcoHz is the current VCO frequency of the QPLL, 0 if unknown.
+* @param	SolPtr is a pointer to the solution to fill in.
+*
+* @return
+*		- XST_SUCCESS if a fractional-N solution was found.
+*		- XST_FAILURE otherwise.
+*
+* @note		The fraction is rounded to the nearest SDM step, which is
+*		well below the reference clock tolerance. Must be called with
+*		XVphy_PllIndexLock held.
+*
+******************************************************************************/
+static u32 XVphy_PllFracSolve(XVphy *InstancePtr, u8 QuadId,
+		XVphy_ChannelId CmnId, u64 RefClkHz, u64 LineRateHz,
+		u64 CurVcoHz, XVphy_PllSolution *SolPtr)
+{
+	const XVphy_GtPllDivs *GtPllDivs = &InstancePtr->GtAdaptor->QpllDivs;
+	XVphy_PllSolution Sol;
+	u64 PllClkOutFreqHz;
+	u64 FbClkFreqHz;
+	u64 NFbDiv;
+	u64 SdmData;
+	u32 Status = XST_FAILURE;
+
+	const u8 *M, *D;
+
+	for (D = GtPllDivs->D; *D != 0; D++) {
+		PllClkOutFreqHz = LineRateHz * *D;
+
+		/* Test if the required PLL clock is in the VCO range. */
+		if (XVphy_CheckPllOpRange(InstancePtr, QuadId, CmnId,
+				PllClkOutFreqHz) != XST_SUCCESS) {
+			continue;
+		}
+
+		for (M = GtPllDivs->M; *M != 0; M++) {
+			FbClkFreqHz = PllClkOutFreqHz * *M;
+			NFbDiv = FbClkFreqHz / RefClkHz;
+			SdmData = (((FbClkFreqHz - (NFbDiv * RefClkHz)) <<
+					XVPHY_QPLL_SDM_WIDTH) + (RefClkHz / 2)) /
+					RefClkHz;
+			if (SdmData == (1ULL << XVPHY_QPLL_SDM_WIDTH)) {
+				NFbDiv++;
+				SdmData = 0;
+			}
+
+			if ((NFbDiv < XVPHY_QPLL_SDM_N_MIN) ||
+			    (NFbDiv > XVPHY_QPLL_SDM_N_MAX) ||
+			    ((NFbDiv == XVPHY_QPLL_SDM_N_MAX) && SdmData)) {
+				continue;
+			}
+
+			Sol.LineRateHz = LineRateHz;
+			Sol.VcoHz = PllClkOutFreqHz;
+			Sol.Order = 0;
+			Sol.M = *M;
+			Sol.N1 = (u8)NFbDiv;
+			Sol.N2 = 1;
+			Sol.D = *D;
+			Sol.SdmEnable = 1;
+			Sol.SdmData = (u32)SdmData;
+
+			if ((Status != XST_SUCCESS) ||
+			    XVphy_PllSolutionBetter(&Sol, SolPtr, CurVcoHz)) {
+				*SolPtr = Sol;
+				Status = XST_SUCCESS;
+			}
+			if (XVphy_PllPolicySel == XVPHY_PLL_POLICY_FIRST) {
+				return Status;
+			}
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function resolves the PLL divider values producing a line rate from
+* a reference clock, falling back to fractional-N mode for GTHE4 QPLLs when
+* no integer divider combination reaches the line rate.
+*
+* @param	InstancePtr is a pointer to the XVphy core instance.
+* @param	QuadId is the GT quad ID to operate on.
+* @param	ChId is the channel ID of the PLL (a channel for the CPLL, or
+*		a common ID for a QPLL).
+* @param	RefClkHz is the PLL reference clock frequency.
+* @param	LineRateHz is the requested line rate.
+* @param	CurVcoHz is the current VCO frequency of the PLL, 0 if unknown.
+* @param	SolPtr is a pointer to the solution to fill in.
+*
+* @return
+*		- XST_SUCCESS if the line rate can be reached.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XVphy_PllSolve(XVphy *InstancePtr, u8 QuadId, XVphy_ChannelId ChId,
+		u64 RefClkHz, u64 LineRateHz, u64 CurVcoHz,
+		XVphy_PllSolution *SolPtr)
+{
+	u32 Status;
+
+	if (!RefClkHz || !LineRateHz || !InstancePtr->GtAdaptor) {
+		return XST_FAILURE;
+	}
+
+	if (XVphy_PllIndexLookup(InstancePtr, QuadId, ChId, RefClkHz,
+			LineRateHz, CurVcoHz, SolPtr) == XST_SUCCESS) {
+		return XST_SUCCESS;
+	}
+
+	/* Only the GTHE4 QPLLs have a fractional-N feedback divider. */
+	if ((InstancePtr->Config.XcvrType != XVPHY_GT_TYPE_GTHE4) ||
+	    ((ChId != XVPHY_CHANNEL_ID_CMN0) &&
+	     (ChId != XVPHY_CHANNEL_ID_CMN1))) {
+		return XST_FAILURE;
+	}
+
+	mutex_lock(&XVphy_PllIndexLock);
+	Status = XVphy_PllFracSolve(InstancePtr, QuadId, ChId, RefClkHz,
+			LineRateHz, CurVcoHz, SolPtr);
+	mutex_unlock(&XVphy_PllIndexLock);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function selects the policy used to choose among the PLL divider
+* solutions producing the same line rate.
+*
+* @param	Policy is the policy to use for subsequent PLL calculations.
+*
+* @return	None.
+*
+* @note		The policy applies to all VPHY instances.
+*
+******************************************************************************/
+void XVphy_PllSetPolicy(XVphy_PllPolicy Policy)
+{
+	if (Policy >= XVPHY_PLL_POLICY_NUM) {
+		return;
+	}
+
+	mutex_lock(&XVphy_PllIndexLock);
+	XVphy_PllPolicySel = Policy;
+	mutex_unlock(&XVphy_PllIndexLock);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the policy used to choose among the PLL divider
+* solutions producing the same line rate.
+*
+* @return	The selected policy.
+*
+* @note		None.
+*
+******************************************************************************/
+XVphy_PllPolicy XVphy_PllGetPolicy(void)
+{
+	return XVphy_PllPolicySel;
+}
@@ -15,6 +15,9 @@
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 /**************************** Type Definitions *******************************/
 
 struct reg_8 {
@@ -32,12 +35,14 @@ static const struct regmap_config dp141_regmap_config = {
  * @client: Pointer to I2C client
  * @ctrls: dp141 control structure
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct dp141 {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
@@ -51,6 +56,7 @@ struct dp141 *dp141;
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -80,6 +86,10 @@ int dp141_init(void)
 {
 	int ret = 0;
 
+	if (xfmc_script_loaded(&dp141->script))
+		return xfmc_script_run(&dp141->client->dev, dp141->regmap,
+				       &dp141->script, 0);
+
 	msleep_range(20);
 	ret = dp141_write_reg(dp141, 0x2, 0x3c);
 	msleep_range(10);
@@ -117,7 +127,7 @@ static int dp141_probe(struct i2c_client *client)
 	mutex_init(&dp141->lock);
 
 	/* initialize regmap */
-	dp141->regmap = devm_regmap_init_i2c(client, &dp141_regmap_config);
+	dp141->regmap = xfmc_regmap_init_i2c(client, &dp141_regmap_config);
 	if (IS_ERR(dp141->regmap)) {
 		dev_err(&client->dev,
 			"regmap init failed: %ld\n", PTR_ERR(dp141->regmap));
@@ -125,6 +135,9 @@ static int dp141_probe(struct i2c_client *client)
 		goto err_regmap;
 	}
 
+	dp141->client = client;
+	xfmc_script_load(&client->dev, "dp141", &dp141->script);
+
 	dev_info(&client->dev, "dp141 : probe success !\n");
 
 	return 0;
@@ -15,6 +15,9 @@
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 /**************************** Type Definitions *******************************/
 
 struct fmcs *fmc;
@@ -22,6 +25,7 @@ struct fmcs *fmc;
 static const struct regmap_config fmc_regmap_config = {
 	.reg_bits = 16,
 	.val_bits = 8,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 /*
@@ -29,12 +33,14 @@ static const struct regmap_config fmc_regmap_config = {
  * @client: Pointer to I2C client
  * @ctrls: fmc control structure
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct fmcs {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
@@ -46,6 +52,7 @@ struct fmcs {
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -73,6 +80,11 @@ int fmc_init(u8 hpc_connector)
 {
 	int ret = 0;
 
+	if (xfmc_script_loaded(&fmc->script) &&
+	    xfmc_script_run(&fmc->client->dev, fmc->regmap, &fmc->script, 0))
+		return 1;
+
+	/* the caller picks the connector, a script cannot override it */
 	ret = fmc_write_reg(fmc, 0x0, hpc_connector);
 	if (ret)
 		return 1;
@@ -103,7 +115,7 @@ static int fmc_probe(struct i2c_client *client)
 
 	mutex_init(&fmc->lock);
 
-	fmc->regmap = devm_regmap_init_i2c(client, &fmc_regmap_config);
+	fmc->regmap = xfmc_regmap_init_i2c(client, &fmc_regmap_config);
 	if (IS_ERR(fmc->regmap)) {
 		dev_err(&client->dev,
 			"Failed to register i2c regmap  %d\n",
@@ -112,6 +124,9 @@ static int fmc_probe(struct i2c_client *client)
 		goto err_regmap;
 	}
 
+	fmc->client = client;
+	xfmc_script_load(&client->dev, "fmc", &fmc->script);
+
 	dev_info(&client->dev, "fmc : probe success !\n");
 
 	return 0;
@@ -14,22 +14,28 @@
 #include <linux/module.h>
 #include <linux/regmap.h>
 #include <linux/slab.h>
+
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
 /**************************** Type Definitions *******************************/
 static const struct regmap_config fmc64_regmap_config = {
 	.reg_bits = 16,
 	.val_bits = 8,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 /*
  * struct fmc64 - fmc64 device structure
  * @client: Pointer to I2C client
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct fmcs64 {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
@@ -43,6 +49,7 @@ struct fmcs64 *fmc64;
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -70,6 +77,10 @@ int fmc64_init(void)
 {
 	int ret = 0;
 
+	if (xfmc_script_loaded(&fmc64->script))
+		return xfmc_script_run(&fmc64->client->dev, fmc64->regmap,
+				       &fmc64->script, 0) ? 1 : 0;
+
 	ret = fmc64_write_reg(fmc64, 0x0, 0x52);
 	if (ret)
 		return 1;
@@ -101,7 +112,7 @@ static int fmc64_probe(struct i2c_client *client)
 	mutex_init(&fmc64->lock);
 
 	/* initialize regmap */
-	fmc64->regmap = devm_regmap_init_i2c(client, &fmc64_regmap_config);
+	fmc64->regmap = xfmc_regmap_init_i2c(client, &fmc64_regmap_config);
 	if (IS_ERR(fmc64->regmap)) {
 		dev_err(&client->dev, "fmc64: regmap init failed: %ld\n",
 			PTR_ERR(fmc64->regmap));
@@ -109,6 +120,9 @@ static int fmc64_probe(struct i2c_client *client)
 		goto err_regmap;
 	}
 
+	fmc64->client = client;
+	xfmc_script_load(&client->dev, "fmc64", &fmc64->script);
+
 	dev_info(&client->dev, "fmc64 : probe success !\n");
 
 	return 0;
@@ -15,23 +15,29 @@
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 /**************************** Type Definitions *******************************/
 
 static const struct regmap_config fmc65_regmap_config = {
 	.reg_bits = 16,
 	.val_bits = 8,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 /*
  * struct fmc65 - fmc65 device structure
  * @client: Pointer to I2C client
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct fmcs64 {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
@@ -45,6 +51,7 @@ struct fmcs64 *fmc65;
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -72,6 +79,10 @@ int fmc65_init(void)
 {
 	int ret = 0;
 
+	if (xfmc_script_loaded(&fmc65->script))
+		return xfmc_script_run(&fmc65->client->dev, fmc65->regmap,
+				       &fmc65->script, 0) ? 1 : 0;
+
 	ret = fmc65_write_reg(fmc65, 0x0, 0x1E);
 	if (ret)
 		return 1;
@@ -103,7 +114,7 @@ static int fmc65_probe(struct i2c_client *client)
 	mutex_init(&fmc65->lock);
 
 	/* initialize regmap */
-	fmc65->regmap = devm_regmap_init_i2c(client, &fmc65_regmap_config);
+	fmc65->regmap = xfmc_regmap_init_i2c(client, &fmc65_regmap_config);
 	if (IS_ERR(fmc65->regmap)) {
 		dev_err(&client->dev, "fmc65: regmap init failed: %ld\n",
 			PTR_ERR(fmc65->regmap));
@@ -111,6 +122,9 @@ static int fmc65_probe(struct i2c_client *client)
 		goto err_regmap;
 	}
 
+	fmc65->client = client;
+	xfmc_script_load(&client->dev, "fmc65", &fmc65->script);
+
 	dev_info(&client->dev, "fmc65 : probe success !\n");
 
 	return 0;
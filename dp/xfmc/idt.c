@@ -8,16 +8,22 @@
  *
  */
 #include <linux/clk.h>
+#include <linux/clk-provider.h>
 #include <linux/delay.h>
 #include <linux/gpio.h>
 #include <linux/gpio/consumer.h>
 #include <linux/i2c.h>
 #include <linux/init.h>
+#include <linux/math64.h>
 #include <linux/module.h>
+#include <linux/of.h>
 #include <linux/of_gpio.h>
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 #define IDT_8T49N24X_REVID 0x0    /**< Device Revision */
 #define IDT_8T49N24X_DEVID 0x0607 /**< Device ID Code */
 
@@ -42,6 +48,32 @@
 #define FALSE 0
 #define XPAR_IIC_0_BASEADDR 0xA0080000
 #define I2C_IDT8N49_ADDR 0x7C
+
+/* The configuration tables are programmed from this register on */
+#define IDT_8T49N24X_REG_CFG_START	0x0008
+/* DPLL and APLL calibration control, never part of a table write */
+#define IDT_8T49N24X_REG_CAL		0x0070
+#define IDT_8T49N24X_CAL_ENABLE		0x05
+/* time the DPLL and APLL need to calibrate and lock */
+#define IDT_8T49N24X_CAL_DELAY_MS	30
+
+/*
+ * Synthesizer dividers. The APLL runs at
+ *	FVCO = 2 * XTAL * (DSM_INT + DSM_FRAC / 2^21)
+ * and output Qx at
+ *	FOUT = FVCO / (2 * (N_Qx + NFRAC_Qx / 2^28))
+ */
+#define IDT_8T49N24X_REG_DSM		0x0025	/* DSM_INT[8:0], DSM_FRAC[20:0] */
+#define IDT_8T49N24X_REG_N_Q3		0x0048	/* N_Q3[17:0] */
+#define IDT_8T49N24X_REG_NFRAC_Q3	0x005f	/* NFRAC_Q3[27:0] */
+#define IDT_8T49N24X_DSM_REGS		6
+#define IDT_8T49N24X_N_REGS		3
+#define IDT_8T49N24X_NFRAC_REGS		4
+
+#define IDT_8T49N24X_DSM_FRAC_BITS	21
+#define IDT_8T49N24X_NFRAC_BITS		28
+#define IDT_8T49N24X_NQ_MIN		4
+#define IDT_8T49N24X_NQ_MAX		(BIT(18) - 1)
 /*
  *  This configuration was created with the IDT timing commander.
  *  IT configures the clock device in synthesizer mode.
@@ -97,6 +129,28 @@ static const u8 idt_8T49n24x_config_xx[] = {
 	0x00, 0x00
 };
 
+/*
+ * Divider and output settings applied by IDT_8T49N24x_SetClock(), with the
+ * calibration switched on while they change.
+ */
+static const struct reg_sequence idt_8T49n24x_set_clock[] = {
+	{ IDT_8T49N24X_REG_CAL, IDT_8T49N24X_CAL_ENABLE, 20 * 1000 },
+	{ 0x000a, 0x30 }, { 0x000a, 0x30 }, { 0x000a, 0x31 },
+	{ 0x0069, 0x0a },
+	{ 0x000b, 0x00 }, { 0x000c, 0x00 }, { 0x000d, 0x00 },
+	{ 0x000e, 0x00 }, { 0x000f, 0x00 }, { 0x0010, 0x00 },
+	{ 0x0014, 0x00 }, { 0x0015, 0x00 }, { 0x0016, 0x00 },
+	{ 0x0011, 0x00 }, { 0x0012, 0x00 }, { 0x0013, 0x00 },
+	{ 0x0025, 0x00 }, { 0x0026, 0x28 }, { 0x0028, 0x10 },
+	{ 0x0029, 0x00 }, { 0x002a, 0x00 },
+	{ 0x0045, 0x00 }, { 0x0046, 0x00 }, { 0x0047, 0x00 },
+	{ 0x0048, 0x00 }, { 0x0049, 0x00 }, { 0x004a, 0x06 },
+	{ 0x005b, 0x00 }, { 0x005c, 0x00 }, { 0x005d, 0x00 },
+	{ 0x005e, 0x00 }, { 0x005f, 0x00 }, { 0x0060, 0x00 },
+	{ 0x0061, 0x00 }, { 0x0062, 0x00 },
+	{ IDT_8T49N24X_REG_CAL, 0x00 },
+};
+
 /**************************** Type Definitions *******************************/
 
 struct reg_8 {
@@ -104,6 +158,20 @@ struct reg_8 {
 	u8 val;
 };
 
+/*
+ * struct idt_dividers - synthesizer divider settings
+ * @dsm_int: APLL feedback divider, integer part
+ * @dsm_frac: APLL feedback divider, fractional part in 1/2^21
+ * @n_q: output divider, integer part
+ * @nfrac_q: output divider, fractional part in 1/2^28
+ */
+struct idt_dividers {
+	u32 dsm_int;
+	u32 dsm_frac;
+	u32 n_q;
+	u32 nfrac_q;
+};
+
 static const struct regmap_config idt_regmap_config = {
 	.reg_bits = 16,
 	.val_bits = 8,
@@ -115,12 +183,16 @@ static const struct regmap_config idt_regmap_config = {
  * @client: Pointer to I2C client
  * @ctrls: idt control structure
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
+ * @hw: Clock of the Q3 synthesizer output
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct idts {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
+	struct clk_hw hw;
 	struct mutex lock; /* mutex lock for operations */
 	u32 mode_index;
 };
@@ -132,6 +204,7 @@ struct idts *idt;
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -160,31 +233,41 @@ static inline int idt_write_reg(struct idts *priv, u16 addr, u8 val)
 
 static int idt_enable(u8 enable)
 {
-	int ret = 0;
+	int ret;
 
-	if (enable) {
-		ret = idt_write_reg(idt, 0x0070, 5);
-		msleep_range(30);
+	ret = idt_write_reg(idt, IDT_8T49N24X_REG_CAL,
+			    enable ? IDT_8T49N24X_CAL_ENABLE : 0);
+	/* only the start of calibration has to settle */
+	if (enable)
+		msleep_range(IDT_8T49N24X_CAL_DELAY_MS);
 
-	} else {
-		ret = idt_write_reg(idt, 0x0070, 0);
-		msleep_range(30);
-	}
 	return ret;
 }
 
-static int idt_8T49n24x_configure_ja(u32 i2c_base_addr, u8 i2c_slave_addr)
+/*
+ * Program a configuration table in two auto-incrementing bulk writes, one on
+ * each side of the calibration control register, which is left untouched.
+ */
+static int idt_write_config(struct idts *priv, const u8 *config, size_t size)
 {
-	int ret = 0;
-	u32 index;
+	int ret;
 
-	for (index = 8; index < sizeof(idt_8T49n24x_config_ja); index++) {
-		msleep_range(10);
-		if (index != 0x070)
-			ret = idt_write_reg(idt, index,
-					    idt_8T49n24x_config_ja[index]);
-	}
-	return ret;
+	ret = regmap_bulk_write(priv->regmap, IDT_8T49N24X_REG_CFG_START,
+				&config[IDT_8T49N24X_REG_CFG_START],
+				IDT_8T49N24X_REG_CAL -
+				IDT_8T49N24X_REG_CFG_START);
+	if (ret || size <= IDT_8T49N24X_REG_CAL + 1)
+		return ret;
+
+	return regmap_bulk_write(priv->regmap, IDT_8T49N24X_REG_CAL + 1,
+				 &config[IDT_8T49N24X_REG_CAL + 1],
+				 size - IDT_8T49N24X_REG_CAL - 1);
+}
+
+static int idt_8T49n24x_configure_ja(u32 i2c_base_addr, u8 i2c_slave_addr)
+{
+	return idt_write_config(idt, idt_8T49n24x_config_ja,
+				sizeof(idt_8T49n24x_config_ja));
 }
 
 /***************************************************************************/
@@ -203,279 +286,278 @@ static int idt_8T49n24x_configure_ja(u32 i2c_base_addr, u8 i2c_slave_addr)
  * **************************************************************************/
 
 int IDT_8T49N24x_Configure(void)
-{
-	int ret = 0;
-	u32 index;
-
-	for (index = 8; index < sizeof(idt_8T49n24x_config_syn); index++) {
-		if (index != 0x070) {
-			ret = idt_write_reg(idt, index,
-					    idt_8T49n24x_config_syn[index]);
-			msleep_range(10);
-		}
-	}
-	return ret;
-}
-EXPORT_SYMBOL_GPL(IDT_8T49N24x_Configure);
-
-int IDT_8T49N24x_SetClock(void)
 {
 	int ret;
 
-	ret = idt_write_reg(idt, 0x0070, 0x5);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n",  __LINE__,  __func__);
-	msleep_range(20);
+	/* a loaded init script already programmed the whole device */
+	if (xfmc_script_loaded(&idt->script))
+		return 0;
 
-	ret = idt_write_reg(idt, 0x000a, 0x30);
+	ret = idt_write_config(idt, idt_8T49n24x_config_syn,
+			       sizeof(idt_8T49n24x_config_syn));
 	if (ret)
 		dev_dbg(&idt->client->dev,
 			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
 
-	ret = idt_write_reg(idt, 0x000a, 0x30);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
-
-	ret  = idt_write_reg(idt, 0x000a, 0x31);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
-
-	ret = idt_write_reg(idt, 0x0069, 0x0a);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
-
-	ret = idt_write_reg(idt, 0x000b, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	return ret;
+}
+EXPORT_SYMBOL_GPL(IDT_8T49N24x_Configure);
 
-	ret = idt_write_reg(idt, 0x000c, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+int IDT_8T49N24x_SetClock(void)
+{
+	int ret;
 
-	ret = idt_write_reg(idt, 0x000d, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	if (xfmc_script_loaded(&idt->script))
+		return 0;
 
-	ret = idt_write_reg(idt, 0x000e, 0x0);
+	ret = regmap_multi_reg_write(idt->regmap, idt_8T49n24x_set_clock,
+				     ARRAY_SIZE(idt_8T49n24x_set_clock));
+	xfmc_account_sleep(idt_8T49n24x_set_clock[0].delay_us);
 	if (ret)
 		dev_dbg(&idt->client->dev,
 			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
 
-	ret = idt_write_reg(idt, 0x000f, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	return ret;
+}
+EXPORT_SYMBOL_GPL(IDT_8T49N24x_SetClock);
 
-	ret = idt_write_reg(idt, 0x0010, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+int IDT_8T49N24x_Init(void)
+{
+	int ret = 0;
 
-	ret = idt_write_reg(idt, 0x0014, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	if (xfmc_script_loaded(&idt->script))
+		return xfmc_script_run(&idt->client->dev, idt->regmap,
+				       &idt->script, XFMC_SCRIPT_MERGE);
 
-	ret = idt_write_reg(idt, 0x0015, 0x0);
+	ret = idt_enable(FALSE);
 	if (ret)
 		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
-
-	ret = idt_write_reg(idt, 0x0016, 0x0);
+			"IDT_8T49N24x_enable 0  I2C progmming failed\n");
+	/* Configure device. */
+	ret = idt_8T49n24x_configure_ja(XPAR_IIC_0_BASEADDR, I2C_IDT8N49_ADDR);
 	if (ret)
 		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+			"idt_8T49n24x_configure_ja I2C progmming failed\n");
 
-	ret = idt_write_reg(idt, 0x0011, 0x0);
+	/* enable DPLL and APLL calibration. */
+	ret = idt_enable(TRUE);
 	if (ret)
 		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+			"IDT_8T49N24x_enable 1 I2C progmming failed\n");
+	return 0;
+}
+EXPORT_SYMBOL_GPL(IDT_8T49N24x_Init);
 
-	ret = idt_write_reg(idt, 0x0012, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+/* FVCO in Hz, scaled by 2^21 */
+static u64 idt_dividers_fvco(const struct idt_dividers *div)
+{
+	return (((u64)div->dsm_int << IDT_8T49N24X_DSM_FRAC_BITS) +
+		div->dsm_frac) * 2 * IDT_8T49N24X_XTAL_FREQ;
+}
 
-	ret = idt_write_reg(idt, 0x0013, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+static unsigned long idt_dividers_rate(const struct idt_dividers *div)
+{
+	u64 nq = ((u64)div->n_q << IDT_8T49N24X_NFRAC_BITS) + div->nfrac_q;
 
-	ret = idt_write_reg(idt, 0x0025, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	if (!nq)
+		return 0;
 
-	ret = idt_write_reg(idt, 0x0026, 0x28);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	/* FVCO / 2^21 / (2 * nq / 2^28) */
+	return DIV64_U64_ROUND_CLOSEST(idt_dividers_fvco(div) << 6, nq);
+}
 
-	ret = idt_write_reg(idt, 0x0028, 0x10);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+/*
+ * idt_solve_dividers - compute the synthesizer dividers for a rate
+ * @rate: output frequency in Hz
+ * @div: resulting divider settings
+ *
+ * Every integer output divider that keeps the VCO in range is tried, and the
+ * one whose VCO the DSM hits most closely wins, an exact one ending the
+ * search. The fractional output divider then absorbs the DSM rounding.
+ *
+ * Return: 0 on success, -EINVAL if the rate is out of range
+ */
+static int idt_solve_dividers(unsigned long rate, struct idt_dividers *div)
+{
+	const u64 fpd = 2ULL * IDT_8T49N24X_XTAL_FREQ;
+	u64 err, best_err = U64_MAX, fvco, rem, frac;
+	u32 n, n_min, n_max, best_n = 0;
+	u64 nq;
+
+	if (rate < IDT_8T49N24X_FOUT_MIN || rate > IDT_8T49N24X_FOUT_MAX)
+		return -EINVAL;
+
+	n_min = max_t(u64, DIV_ROUND_UP_ULL(IDT_8T49N24X_FVCO_MIN, 2ULL * rate),
+		      IDT_8T49N24X_NQ_MIN);
+	n_max = min_t(u64, div64_u64(IDT_8T49N24X_FVCO_MAX, 2ULL * rate),
+		      IDT_8T49N24X_NQ_MAX);
+
+	for (n = n_min; n <= n_max; n++) {
+		fvco = 2ULL * n * rate;
+		div64_u64_rem(fvco, fpd, &rem);
+		frac = DIV64_U64_ROUND_CLOSEST(rem << IDT_8T49N24X_DSM_FRAC_BITS,
+					       fpd);
+		/* VCO error in Hz scaled by 2^21, per unit of output divider */
+		err = abs_diff(rem << IDT_8T49N24X_DSM_FRAC_BITS, frac * fpd);
+		if (best_n && err * best_n >= best_err * n)
+			continue;
+
+		best_n = n;
+		best_err = err;
+		div->dsm_int = div64_u64(fvco, fpd);
+		div->dsm_frac = frac;
+		if (frac >> IDT_8T49N24X_DSM_FRAC_BITS) {
+			div->dsm_int++;
+			div->dsm_frac = 0;
+		}
+		if (!err)
+			break;
+	}
 
-	ret = idt_write_reg(idt, 0x0029, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	if (!best_n)
+		return -EINVAL;
 
-	ret = idt_write_reg(idt, 0x002a, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	nq = DIV64_U64_ROUND_CLOSEST(idt_dividers_fvco(div) << 6, rate);
+	div->n_q = nq >> IDT_8T49N24X_NFRAC_BITS;
+	div->nfrac_q = nq & (BIT(IDT_8T49N24X_NFRAC_BITS) - 1);
 
-	ret = idt_write_reg(idt, 0x0045, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
+	return 0;
+}
 
-	msleep_range(10);
+/*
+ * Program only the synthesizer divider registers, with the calibration held
+ * off as in IDT_8T49N24x_SetClock(). Only output Q3, the GT reference clock,
+ * is set; N_Q2/NFRAC_Q2 keep what was loaded, which SetClock() clears.
+ */
+static int idt_write_dividers(struct idts *priv, const struct idt_dividers *div)
+{
+	const struct reg_sequence seq[] = {
+		{ IDT_8T49N24X_REG_CAL, IDT_8T49N24X_CAL_ENABLE, 20 * 1000 },
+		{ IDT_8T49N24X_REG_DSM, (div->dsm_int >> 8) & 0x01 },
+		{ IDT_8T49N24X_REG_DSM + 1, div->dsm_int & 0xff },
+		{ IDT_8T49N24X_REG_DSM + 3, (div->dsm_frac >> 16) & 0x1f },
+		{ IDT_8T49N24X_REG_DSM + 4, (div->dsm_frac >> 8) & 0xff },
+		{ IDT_8T49N24X_REG_DSM + 5, div->dsm_frac & 0xff },
+		{ IDT_8T49N24X_REG_N_Q3, (div->n_q >> 16) & 0x03 },
+		{ IDT_8T49N24X_REG_N_Q3 + 1, (div->n_q >> 8) & 0xff },
+		{ IDT_8T49N24X_REG_N_Q3 + 2, div->n_q & 0xff },
+		{ IDT_8T49N24X_REG_NFRAC_Q3, (div->nfrac_q >> 24) & 0x0f },
+		{ IDT_8T49N24X_REG_NFRAC_Q3 + 1, (div->nfrac_q >> 16) & 0xff },
+		{ IDT_8T49N24X_REG_NFRAC_Q3 + 2, (div->nfrac_q >> 8) & 0xff },
+		{ IDT_8T49N24X_REG_NFRAC_Q3 + 3, div->nfrac_q & 0xff },
+		{ IDT_8T49N24X_REG_CAL, 0x00 },
+	};
+
+	return regmap_multi_reg_write(priv->regmap, seq, ARRAY_SIZE(seq));
+}
 
-	ret = idt_write_reg(idt, 0x0046, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+/* read back the dividers of output Q3, from the register cache */
+static int idt_read_dividers(struct idts *priv, struct idt_dividers *div)
+{
+	u8 dsm[IDT_8T49N24X_DSM_REGS];
+	u8 n[IDT_8T49N24X_N_REGS];
+	u8 nfrac[IDT_8T49N24X_NFRAC_REGS];
+	int ret;
 
-	ret = idt_write_reg(idt, 0x0047, 0x0);
+	ret = regmap_bulk_read(priv->regmap, IDT_8T49N24X_REG_DSM, dsm,
+			       sizeof(dsm));
+	if (!ret)
+		ret = regmap_bulk_read(priv->regmap, IDT_8T49N24X_REG_N_Q3, n,
+				       sizeof(n));
+	if (!ret)
+		ret = regmap_bulk_read(priv->regmap, IDT_8T49N24X_REG_NFRAC_Q3,
+				       nfrac, sizeof(nfrac));
 	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+		return ret;
 
-	ret = idt_write_reg(idt, 0x0048, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	div->dsm_int = (dsm[0] & 0x01) << 8 | dsm[1];
+	div->dsm_frac = (dsm[3] & 0x1f) << 16 | dsm[4] << 8 | dsm[5];
+	div->n_q = (n[0] & 0x03) << 16 | n[1] << 8 | n[2];
+	div->nfrac_q = (nfrac[0] & 0x0f) << 24 | nfrac[1] << 16 |
+		       nfrac[2] << 8 | nfrac[3];
 
-	ret = idt_write_reg(idt, 0x0049, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	return 0;
+}
 
-	ret = idt_write_reg(idt, 0x004a, 0x6);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+static unsigned long idt_clk_recalc_rate(struct clk_hw *hw,
+					 unsigned long parent_rate)
+{
+	struct idts *priv = container_of(hw, struct idts, hw);
+	struct idt_dividers div;
 
-	ret = idt_write_reg(idt, 0x005b, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
+	if (idt_read_dividers(priv, &div))
+		return 0;
 
-	msleep_range(10);
+	return idt_dividers_rate(&div);
+}
 
-	ret = idt_write_reg(idt, 0x005c, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+static int idt_clk_determine_rate(struct clk_hw *hw,
+				  struct clk_rate_request *req)
+{
+	struct idt_dividers div;
+	int ret;
 
-	ret = idt_write_reg(idt, 0x005d, 0x0);
+	ret = idt_solve_dividers(req->rate, &div);
 	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+		return ret;
 
-	ret = idt_write_reg(idt, 0x005e, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	req->rate = idt_dividers_rate(&div);
 
-	ret = idt_write_reg(idt, 0x005f, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	return 0;
+}
 
-	ret = idt_write_reg(idt, 0x0060, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+static int idt_clk_set_rate(struct clk_hw *hw, unsigned long rate,
+			    unsigned long parent_rate)
+{
+	struct idts *priv = container_of(hw, struct idts, hw);
+	struct idt_dividers div;
+	int ret;
 
-	ret = idt_write_reg(idt, 0x0061, 0x0);
+	ret = idt_solve_dividers(rate, &div);
 	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+		return ret;
 
-	ret = idt_write_reg(idt, 0x0062, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	dev_dbg(&priv->client->dev,
+		"%lu Hz: dsm %u + %u/2^21, n %u + %u/2^28\n", rate,
+		div.dsm_int, div.dsm_frac, div.n_q, div.nfrac_q);
 
-	ret = idt_write_reg(idt, 0x0070, 0x0);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"%d %s i2c write failed\n", __LINE__, __func__);
-	msleep_range(10);
+	mutex_lock(&priv->lock);
+	ret = idt_write_dividers(priv, &div);
+	mutex_unlock(&priv->lock);
 
 	return ret;
 }
-EXPORT_SYMBOL_GPL(IDT_8T49N24x_SetClock);
 
-int IDT_8T49N24x_Init(void)
+static const struct clk_ops idt_clk_ops = {
+	.recalc_rate = idt_clk_recalc_rate,
+	.determine_rate = idt_clk_determine_rate,
+	.set_rate = idt_clk_set_rate,
+};
+
+static int idt_register_clk(struct idts *priv)
 {
-	int ret = 0;
+	struct device *dev = &priv->client->dev;
+	struct clk_init_data init = {
+		.name = dev_name(dev),
+		.ops = &idt_clk_ops,
+		/*
+		 * SetClock(), Configure() and the init script rewrite the
+		 * dividers behind the framework, read them back every time
+		 */
+		.flags = CLK_GET_RATE_NOCACHE,
+	};
+	int ret;
 
-	msleep_range(30);
-	ret = idt_enable(FALSE);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"IDT_8T49N24x_enable 0  I2C progmming failed\n");
-	msleep_range(30);
-	/* Configure device. */
-	ret = idt_8T49n24x_configure_ja(XPAR_IIC_0_BASEADDR, I2C_IDT8N49_ADDR);
-	if (ret)
-		dev_dbg(&idt->client->dev,
-			"idt_8T49n24x_configure_ja I2C progmming failed\n");
+	of_property_read_string(dev->of_node, "clock-output-names", &init.name);
+	priv->hw.init = &init;
 
-	msleep_range(30);
-	/* enable DPLL and APLL calibration. */
-	ret = idt_enable(TRUE);
+	ret = devm_clk_hw_register(dev, &priv->hw);
 	if (ret)
-		dev_dbg(&idt->client->dev,
-			"IDT_8T49N24x_enable 1 I2C progmming failed\n");
-	msleep_range(30);
-	return 0;
+		return ret;
+
+	return devm_of_clk_add_hw_provider(dev, of_clk_hw_simple_get,
+					   &priv->hw);
 }
-EXPORT_SYMBOL_GPL(IDT_8T49N24x_Init);
 
 static const struct of_device_id idt_of_id_table[] = {
 	{ .compatible = "expander-idt" },
@@ -499,9 +581,10 @@ static int idt_probe(struct i2c_client *client)
 		return -ENOMEM;
 
 	mutex_init(&idt->lock);
+	idt->client = client;
 
 	/* initialize regmap */
-	idt->regmap = devm_regmap_init_i2c(client, &idt_regmap_config);
+	idt->regmap = xfmc_regmap_init_i2c(client, &idt_regmap_config);
 	if (IS_ERR(idt->regmap)) {
 		dev_err(&client->dev,
 			"regmap init failed: %ld\n", PTR_ERR(idt->regmap));
@@ -509,6 +592,12 @@ static int idt_probe(struct i2c_client *client)
 		goto err_regmap;
 	}
 
+	ret = idt_register_clk(idt);
+	if (ret)
+		dev_warn(&client->dev, "clock registration failed: %d\n", ret);
+
+	xfmc_script_load(&client->dev, "idt", &idt->script);
+
 	dev_info(&client->dev, "idt : probe success !\n");
 	return 0;
 
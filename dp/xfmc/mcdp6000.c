@@ -11,10 +11,14 @@
 #include <linux/delay.h>
 #include <linux/i2c.h>
 #include <linux/init.h>
+#include <linux/iopoll.h>
 #include <linux/module.h>
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 #define SWAP_BYTES(u32Value) ((u32Value & 0x000000FF) << 24)\
 |((u32Value & 0x0000FF00) << 8) \
 |((u32Value & 0x00FF0000) >> 8) \
@@ -27,9 +31,28 @@ struct reg_8 {
 	u32 val;
 };
 
+/*
+ * Only the control registers toggled during link training are cached; every
+ * other register, status and counters included, is always read from the
+ * retimer.
+ */
+static bool mcdp6000_volatile_reg(struct device *dev, unsigned int reg)
+{
+	switch (reg) {
+	case 0x000a:
+	case 0x0405:
+	case 0x5001:
+		return false;
+	default:
+		return true;
+	}
+}
+
 static const struct regmap_config mcdp6000_regmap_config = {
 	.reg_bits = 16,
 	.val_bits = 32,
+	.volatile_reg = mcdp6000_volatile_reg,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 /*
@@ -37,18 +60,111 @@ static const struct regmap_config mcdp6000_regmap_config = {
  * @client: Pointer to I2C client
  * @ctrls: mcdp6000 control structure
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct mcdp6000 {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
 	u32 mode_index;
 };
 
+/*
+ * struct mcdp6000_init_step - one register write of an init sequence
+ * @addr: register address
+ * @val: value as written on the bus, see mcdp6000_write_reg()
+ * @bs: bond option the write applies to, 0 for all of them
+ * @delay_ms: settle time after the write, only where a block is reset or
+ *	      powered up; there is no status bit telling when that is done
+ */
+struct mcdp6000_init_step {
+	u16 addr;
+	u32 val;
+	u8 bs;
+	u8 delay_ms;
+};
+
+/*
+ * struct mcdp6000_init_seq - init sequence of a silicon revision
+ * @rev: revision, as read from register 0x1005
+ * @steps: register writes
+ * @num_steps: number of register writes
+ */
+struct mcdp6000_init_seq {
+	u32 rev;
+	const struct mcdp6000_init_step *steps;
+	unsigned int num_steps;
+};
+
+#define MCDP6000_REG_REV		0x1005
+#define MCDP6000_REV_MASK		0xFF00
+#define MCDP6000_BS_MASK		0x1C
+/* the retimer answers with its revision once it is out of reset */
+#define MCDP6000_READY_POLL_US		1000
+#define MCDP6000_READY_TIMEOUT_US	100000
+
+static const struct mcdp6000_init_step mcdp6000_init_2100[] = {
+	{ 0x5003, 0x1F000000, 0, 100 },
+	{ 0x0405, 0x5E700000, 0, 100 },
+	{ 0x8C27, 0x90010000 },
+	{ 0x0C01, 0x242D0F0F },
+	{ 0x0405, 0x5E710000, 0, 100 },
+	{ 0x0405, 0x5E700000, 0, 100 },
+	{ 0x1426, 0x0F0F071A },
+	{ 0xA001, 0x444488CC },
+	{ 0xC001, 0x1EA8002C },
+	{ 0xD001, 0x60C30000 },
+	{ 0x7801, 0x80144713 },
+	{ 0x0809, 0x000C0000 },
+	{ 0x000B, 0x00000000 },
+	{ 0x040B, 0x00000000 },
+	{ 0x0C09, 0x00000202 },
+};
+
+static const struct mcdp6000_init_step mcdp6000_init_3100[] = {
+	{ 0x5003, 0x1f000000, 0, 100 },
+	{ 0x0405, 0x5e700100, 0, 100 },
+	{ 0xc001, 0x9e2c002c },
+	{ 0x2c09, 0xa5a55555 },
+	{ 0x0009, 0x06050104 },
+	{ 0x7801, 0x80144713 },
+	{ 0xa001, 0x444488cc },
+	{ 0x1426, 0x0f0f8919 },
+	{ 0x4023, 0x00050000, 0x18 },
+	{ 0x4025, 0x00050000, 0x18 },
+	{ 0x4022, 0x00050000, 0x08 },
+	{ 0x4024, 0x00050000, 0x08 },
+	{ 0x0816, 0x04847400 },
+	{ 0x0826, 0x04847400 },
+};
+
+static const struct mcdp6000_init_step mcdp6000_init_3200[] = {
+	{ 0x4c02, 0x501a2222 },
+	{ 0x5003, 0x1f000000, 0, 20 },
+	{ 0x0405, 0x5e700100, 0, 20 },
+	{ 0x1426, 0x0f0f8919 },
+	{ 0xd801, 0x01060000 },
+	{ 0x6006, 0x11500000 },
+	{ 0x7c06, 0x01000000 },
+	{ 0x0809, 0x66080000 },
+	{ 0x0c09, 0x00000204 },
+	{ 0x4023, 0x00050000, 0x18 },
+	{ 0x4025, 0x00050000, 0x18 },
+	{ 0x4022, 0x00050000, 0x08 },
+	{ 0x4024, 0x00050000, 0x08 },
+};
+
+static const struct mcdp6000_init_seq mcdp6000_init_seqs[] = {
+	{ 0x2100, mcdp6000_init_2100, ARRAY_SIZE(mcdp6000_init_2100) },
+	{ 0x3100, mcdp6000_init_3100, ARRAY_SIZE(mcdp6000_init_3100) },
+	{ 0x3200, mcdp6000_init_3200, ARRAY_SIZE(mcdp6000_init_3200) },
+};
+
 struct mcdp6000 *mcdp6000;
 u32 mcdp6000_rev;
 /*
@@ -56,6 +172,7 @@ u32 mcdp6000_rev;
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -86,57 +203,68 @@ static inline int mcdp6000_write_reg(struct mcdp6000 *priv, u16 addr, u32 val)
 	return err;
 }
 
+/*
+ * Read-modify-write with val and mask in the byte order returned by
+ * mcdp6000_read_reg(). The read comes from the cache for cached registers,
+ * and nothing is written when the value does not change.
+ */
 static inline int mcdp6000_modify_reg(struct mcdp6000 *priv, u16 addr, u32 val,
 				      u32 mask)
 {
-	u32 data, err;
-
-	err = mcdp6000_read_reg(priv, addr, &data);
-	/* clear masked bits */
-	data &= ~mask;
+	u32 bus_val, bus_mask;
+	int err;
 
-	/* update */
-	data |= (val & mask);
-	data = SWAP_BYTES(data);
+	bus_val = val & mask;
+	bus_val = SWAP_BYTES(bus_val);
+	bus_mask = SWAP_BYTES(mask);
 
-	err |= mcdp6000_write_reg(priv, addr, data);
+	err = regmap_update_bits(priv->regmap, addr, bus_mask, bus_val);
+	if (err < 0)
+		dev_dbg(&priv->client->dev, "mcdp6000 :regmap_modify failed\n");
 
 	return err;
 }
 
-static int mcdp6000_reset_dp_path(void)
+/*
+ * Write a register twice back to back, as needed for the reset and lane-set
+ * strobes. Both values are as written on the bus.
+ */
+static int mcdp6000_pulse_reg(struct mcdp6000 *priv, u16 addr, u32 set,
+			      u32 clear)
 {
-	int ret = 0;
+	const struct reg_sequence seq[] = {
+		{ addr, set },
+		{ addr, clear },
+	};
+	int err;
 
-	ret |= mcdp6000_write_reg(mcdp6000, 0x0405, 0x5E710100);
-	if (ret < 0)
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_modify failed\n");
+	err = regmap_multi_reg_write(priv->regmap, seq, ARRAY_SIZE(seq));
+	if (err < 0)
+		dev_dbg(&priv->client->dev, "mcdp6000 :regmap_write failed\n");
 
-	ret |= mcdp6000_write_reg(mcdp6000, 0x0405, 0x5E700100);
-	if (ret < 0)
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_modify failed\n");
+	return err;
+}
 
-	return ret;
+static int mcdp6000_reset_dp_path(void)
+{
+	return mcdp6000_pulse_reg(mcdp6000, 0x0405, 0x5E710100, 0x5E700100);
 }
 
 static int mcdp6000_reset_cr_path(void)
 {
-	int ret = 0;
-
+	u32 data, set, clear;
+	int ret;
 
-	ret |= mcdp6000_modify_reg(mcdp6000, 0x5001, 0x00008000, 0x00008000);
+	/* cached, this does not go out on the bus */
+	ret = mcdp6000_read_reg(mcdp6000, 0x5001, &data);
 	if (ret < 0)
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_modify failed\n");
+		return ret;
 
-	ret |= mcdp6000_modify_reg(mcdp6000, 0x5001, 0x00000000, 0x00008000);
-	if (ret < 0)
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_modify failed\n");
+	set = data | 0x00008000;
+	clear = data & ~0x00008000;
 
-	return ret;
+	return mcdp6000_pulse_reg(mcdp6000, 0x5001, SWAP_BYTES(set),
+				  SWAP_BYTES(clear));
 }
 
 static int  mcdp6000_access_laneset(void)
@@ -144,19 +272,10 @@ static int  mcdp6000_access_laneset(void)
 	int ret = 0;
 
 	dev_dbg(&mcdp6000->client->dev,"%s: %d\n",__func__,__LINE__);
-	ret = mcdp6000_write_reg(mcdp6000, 0x5001, 0x01000000);
-	if (ret) {
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_write failed\n");
+	ret = mcdp6000_pulse_reg(mcdp6000, 0x5001, 0x01000000, 0x00000000);
+	if (ret)
 		return 1;
-	}
 
-	ret = mcdp6000_write_reg(mcdp6000, 0x5001, 0x00000000);
-	if (ret) {
-		dev_dbg(&mcdp6000->client->dev,
-			"mcdp6000 :regmap_write failed\n");
-		return 1;
-	}
 	return 0;
 }
 
@@ -242,109 +361,82 @@ int XDpRxSs_MCDP6000_ClearCounter(void)
 }
 EXPORT_SYMBOL_GPL(XDpRxSs_MCDP6000_ClearCounter);
 
+static const struct mcdp6000_init_seq *mcdp6000_find_init_seq(u32 rev)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(mcdp6000_init_seqs); i++)
+		if (mcdp6000_init_seqs[i].rev == (rev & MCDP6000_REV_MASK))
+			return &mcdp6000_init_seqs[i];
+
+	return NULL;
+}
+
+static int mcdp6000_run_init_seq(struct mcdp6000 *priv,
+				 const struct mcdp6000_init_seq *seq, u32 bs)
+{
+	const struct mcdp6000_init_step *step;
+	int ret;
+
+	for (step = seq->steps; step < seq->steps + seq->num_steps; step++) {
+		if (step->bs && step->bs != bs)
+			continue;
+		ret = mcdp6000_write_reg(priv, step->addr, step->val);
+		if (ret < 0)
+			return ret;
+		if (step->delay_ms)
+			msleep_range(step->delay_ms);
+	}
+
+	return 0;
+}
+
+/* a loaded script covers revisions without a built-in sequence */
+static bool mcdp6000_rev_known(u32 rev)
+{
+	return xfmc_script_loaded(&mcdp6000->script) ||
+	       mcdp6000_find_init_seq(rev);
+}
+
 int mcdp6000_init(void)
 {
+	const struct mcdp6000_init_seq *seq;
 	int ret = 0;
+	int err;
 	u32 mcdp6000_bs, rev;
 
-	mcdp6000_read_reg(mcdp6000, 0x1005, &rev);
-	mcdp6000_rev = rev & 0xFF00;
-	mcdp6000_bs = rev & 0x1c;
+	/*
+	 * Wait for the retimer to report a revision we can initialize. It
+	 * NAKs while still held in reset, so read errors mean not ready yet.
+	 */
+	ret = read_poll_timeout(mcdp6000_read_reg, err,
+				!err && mcdp6000_rev_known(rev),
+				MCDP6000_READY_POLL_US,
+				MCDP6000_READY_TIMEOUT_US, false,
+				mcdp6000, MCDP6000_REG_REV, &rev);
+	if (ret) {
+		dev_err(&mcdp6000->client->dev,
+			"mcdp6000 : no known revision reported\n");
+		return ret;
+	}
+
+	mcdp6000_rev = rev & MCDP6000_REV_MASK;
+	mcdp6000_bs = rev & MCDP6000_BS_MASK;
 
 	dev_info(&mcdp6000->client->dev,
 		 "mcdp6000 : revision no %x bs: %x\n",mcdp6000_rev, mcdp6000_bs);
 
-	if (mcdp6000_rev == 0x2100) {
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x5003, 0x1F000000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0405, 0x5E700000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x8C27, 0x90010000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0C01, 0x242D0F0F);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0405, 0x5E710000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0405, 0x5E700000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x1426, 0x0F0F071A);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0xA001, 0x444488CC);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0xC001, 0x1EA8002C);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0xD001, 0x60C30000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x7801, 0x80144713);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0809, 0x000C0000);
-		msleep(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x000B, 0x00000000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x040B, 0x00000000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0C09, 0x00000202);
-		msleep_range(100);
-	} else if (mcdp6000_rev == 0x3100) {
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x5003, 0x1f000000);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0405, 0x5e700100);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0xc001, 0x9e2c002c);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x2c09, 0xa5a55555);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0009, 0x06050104);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x7801, 0x80144713);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0xa001, 0x444488cc);
-		msleep_range(100);
-		ret = mcdp6000_write_reg(mcdp6000, 0x1426, 0x0f0f8919);
-		if (mcdp6000_bs == 0x18) {
-			ret = mcdp6000_write_reg(mcdp6000, 0x4023, 0x00050000);
-			msleep_range(100);
-			ret = mcdp6000_write_reg(mcdp6000, 0x4025, 0x00050000);
-		} else if (mcdp6000_bs == 0x8){
-			ret = mcdp6000_write_reg(mcdp6000, 0x4022, 0x00050000);
-			ret = mcdp6000_write_reg(mcdp6000, 0x4024, 0x00050000);
-		}
-		ret = mcdp6000_write_reg(mcdp6000, 0x0816, 0x04847400);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0826, 0x04847400);
-
-	} else if (mcdp6000_rev == 0x3200) {
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x4c02, 0x501a2222);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x5003, 0x1f000000);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0405, 0x5e700100);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x1426, 0x0f0f8919);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0xd801, 0x01060000);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x6006, 0x11500000);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x7c06, 0x01000000);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0809, 0x66080000);
-		msleep_range(20);
-		ret = mcdp6000_write_reg(mcdp6000, 0x0c09, 0x00000204);
-		msleep_range(20);
-		if (mcdp6000_bs == 0x18) {
-			ret = mcdp6000_write_reg(mcdp6000, 0x4023, 0x00050000);
-			msleep_range(20);
-			ret = mcdp6000_write_reg(mcdp6000, 0x4025, 0x00050000);
-			msleep_range(20);
-		} else if (mcdp6000_bs == 0x8) {
-			ret = mcdp6000_write_reg(mcdp6000, 0x4022, 0x00050000);
-			msleep_range(20);
-			ret = mcdp6000_write_reg(mcdp6000, 0x4024, 0x00050000);
-			msleep_range(20);
-		}
+	/* the callbacks still key off the revision read above */
+	if (xfmc_script_loaded(&mcdp6000->script))
+		return xfmc_script_run(&mcdp6000->client->dev, mcdp6000->regmap,
+				       &mcdp6000->script, 0);
+
+	seq = mcdp6000_find_init_seq(mcdp6000_rev);
+	if (seq) {
+		ret = mcdp6000_run_init_seq(mcdp6000, seq, mcdp6000_bs);
+		if (ret < 0)
+			dev_dbg(&mcdp6000->client->dev,
+				"mcdp6000 : init sequence failed\n");
 	}
 
 	return 0;
@@ -376,7 +468,7 @@ static int mcdp6000_probe(struct i2c_client *client)
 	mcdp6000->client = client;
 
 	/* initialize regmap */
-	mcdp6000->regmap = devm_regmap_init_i2c(client,
+	mcdp6000->regmap = xfmc_regmap_init_i2c(client,
 						&mcdp6000_regmap_config);
 	if (IS_ERR(mcdp6000->regmap)) {
 		dev_err(&client->dev,
@@ -384,6 +476,8 @@ static int mcdp6000_probe(struct i2c_client *client)
 		ret = -ENODEV;
 		goto err_regmap;
 	}
+	xfmc_script_load(&client->dev, "mcdp6000", &mcdp6000->script);
+
 	dev_info(&client->dev, "mcdp6000 : probe success !\n");
 
 	return 0;
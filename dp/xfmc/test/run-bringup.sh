@@ -0,0 +1,81 @@
+#!/bin/sh
+# SPDX-License-Identifier: GPL-2.0
+#
+# Run the Video FMC bring-up against the simulated I2C bus and check what
+# it left in the device registers.
+#
+# Build the modules with "make XFMC_SIM=m" in dp/, then as root:
+#
+#   run-bringup.sh [-r] [-n runs] [-m rev] [golden-dir]
+#
+# The bring-up runs once when the modules load and runs-1 more times through
+# debugfs; each run's per-device report (wall time, sleep, I2C transfers and
+# bytes) is printed. The final register dump of each device is compared
+# against golden-dir, or recorded there with -r. The mcdp6000 retimer
+# reports revision rev, 3100 by default, and golden-dir defaults to
+# golden/<rev> next to this script. The dumps assume no init script is
+# installed under /lib/firmware/xilinx/xfmc.
+
+set -e
+
+here=$(cd "$(dirname "$0")" && pwd)
+moddir=${MODDIR:-$here/../..}
+debugfs=/sys/kernel/debug
+record=0
+runs=1
+rev=3100
+
+while getopts rn:m: opt; do
+	case $opt in
+	r) record=1 ;;
+	n) runs=$OPTARG ;;
+	m) rev=$OPTARG ;;
+	*) echo "usage: $0 [-r] [-n runs] [-m rev] [golden-dir]" >&2; exit 2 ;;
+	esac
+done
+shift $((OPTIND - 1))
+golden=${1:-$here/golden/$rev}
+
+mountpoint -q $debugfs || mount -t debugfs none $debugfs
+
+cleanup() {
+	rmmod xfmc_i2c_sim 2>/dev/null || true
+	rmmod xilinx_vfmc 2>/dev/null || true
+}
+trap cleanup EXIT
+
+insmod "$moddir/xilinx-vfmc.ko"
+insmod "$moddir/xfmc/test/xfmc_i2c_sim.ko" mcdp6000_rev=0x$rev
+
+bringup=$debugfs/xilinx-vfmc/bringup
+[ -e $bringup ] || { echo "xilinx-vfmc did not probe" >&2; exit 1; }
+
+run=1
+while :; do
+	echo "run $run:"
+	cat $bringup
+	[ $run -lt $runs ] || break
+	run=$((run + 1))
+	echo run > $bringup
+done
+
+dump=$(mktemp -d)
+for f in $debugfs/xfmc-i2c-sim/*; do
+	cat "$f" > "$dump/${f##*/}"
+done
+
+if [ $record -eq 1 ]; then
+	mkdir -p "$golden"
+	cp "$dump"/* "$golden/"
+	echo "recorded register dump in $golden"
+	rm -rf "$dump"
+	exit 0
+fi
+
+[ -d "$golden" ] || { echo "no $golden, record one with -r" >&2; exit 1; }
+
+status=0
+diff -ru "$golden" "$dump" || status=1
+rm -rf "$dump"
+[ $status -eq 0 ] && echo "register dump matches $golden"
+exit $status
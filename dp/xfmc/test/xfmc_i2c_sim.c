@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Simulated I2C bus carrying the Video FMC devices
+ *
+ * Copyright (C) 2020 Xilinx, Inc.
+ *
+ * Lets the FMC bring-up run without the card: each device answers at its
+ * usual address as a plain register file that acks every transfer. Loading
+ * this module binds the FMC drivers and the xilinx-vfmc platform device,
+ * which runs the bring-up; debugfs then shows what each device was left
+ * with, one "reg value" line per register written.
+ *
+ * i2c-stub only speaks SMBus, which regmap cannot use for the 16-bit
+ * register addresses most of these devices have, hence this adapter.
+ */
+#include <linux/debugfs.h>
+#include <linux/i2c.h>
+#include <linux/kernel.h>
+#include <linux/module.h>
+#include <linux/platform_device.h>
+#include <linux/seq_file.h>
+#include <linux/swab.h>
+#include <linux/xarray.h>
+
+#define XFMC_SIM_MCDP6000_REG_REV	0x1005
+
+static ushort mcdp6000_rev = 0x3100;
+module_param(mcdp6000_rev, ushort, 0444);
+MODULE_PARM_DESC(mcdp6000_rev, "revision the mcdp6000 retimer reports");
+
+/**
+ * struct xfmc_sim_chip - a simulated FMC device
+ * @name: I2C device name, binds the FMC driver of the same name
+ * @addr: 7-bit I2C address
+ * @reg_bytes: register address width on the wire
+ * @val_bytes: register width on the wire
+ * @regs: register file, values stored as xa_mk_value(), which only has
+ *	room for 32-bit registers on 64-bit kernels
+ * @ptr: register the next transfer starts at, auto-incremented
+ * @client: the client the FMC driver binds to
+ */
+struct xfmc_sim_chip {
+	const char *name;
+	u16 addr;
+	u8 reg_bytes;
+	u8 val_bytes;
+	struct xarray regs;
+	u16 ptr;
+	struct i2c_client *client;
+};
+
+static struct xfmc_sim_chip xfmc_sim_chips[] = {
+	{ "FMC",	0x75, 2, 1 },
+	{ "FMC64",	0x64, 2, 1 },
+	{ "FMC65",	0x65, 2, 1 },
+	{ "IDT",	0x7c, 2, 1 },
+	{ "TIPOWER",	0x50, 1, 1 },
+	{ "mcdp6000",	0x14, 2, 4 },
+	{ "dp141",	0x05, 1, 1 },
+};
+
+static struct platform_device *xfmc_sim_pdev;
+static struct dentry *xfmc_sim_debugfs;
+
+static struct xfmc_sim_chip *xfmc_sim_find(u16 addr)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(xfmc_sim_chips); i++)
+		if (xfmc_sim_chips[i].addr == addr)
+			return &xfmc_sim_chips[i];
+
+	return NULL;
+}
+
+/* big-endian, as regmap puts register addresses and values on the wire */
+static u32 xfmc_sim_get_be(const u8 *buf, int len)
+{
+	u32 val = 0;
+	int i;
+
+	for (i = 0; i < len; i++)
+		val = (val << 8) | buf[i];
+
+	return val;
+}
+
+static void xfmc_sim_put_be(u8 *buf, int len, u32 val)
+{
+	int i;
+
+	for (i = len - 1; i >= 0; i--) {
+		buf[i] = val & 0xff;
+		val >>= 8;
+	}
+}
+
+static int xfmc_sim_write(struct xfmc_sim_chip *chip, struct i2c_msg *msg)
+{
+	u8 *buf = msg->buf;
+	int len = msg->len;
+	int err;
+
+	if (len < chip->reg_bytes)
+		return 0;
+
+	chip->ptr = xfmc_sim_get_be(buf, chip->reg_bytes);
+	buf += chip->reg_bytes;
+	len -= chip->reg_bytes;
+
+	for (; len >= chip->val_bytes; len -= chip->val_bytes) {
+		err = xa_err(xa_store(&chip->regs, chip->ptr++,
+				      xa_mk_value(xfmc_sim_get_be(buf,
+						  chip->val_bytes)),
+				      GFP_KERNEL));
+		if (err)
+			return err;
+		buf += chip->val_bytes;
+	}
+
+	return 0;
+}
+
+static void xfmc_sim_read(struct xfmc_sim_chip *chip, struct i2c_msg *msg)
+{
+	u8 *buf = msg->buf;
+	int len;
+	void *entry;
+
+	for (len = msg->len; len >= chip->val_bytes; len -= chip->val_bytes) {
+		entry = xa_load(&chip->regs, chip->ptr++);
+		xfmc_sim_put_be(buf, chip->val_bytes,
+				entry ? xa_to_value(entry) : 0);
+		buf += chip->val_bytes;
+	}
+}
+
+static int xfmc_sim_xfer(struct i2c_adapter *adap, struct i2c_msg *msgs,
+			 int num)
+{
+	struct xfmc_sim_chip *chip;
+	int i, err;
+
+	for (i = 0; i < num; i++) {
+		chip = xfmc_sim_find(msgs[i].addr);
+		if (!chip)
+			return -ENXIO;
+
+		if (msgs[i].flags & I2C_M_RD) {
+			xfmc_sim_read(chip, &msgs[i]);
+		} else {
+			err = xfmc_sim_write(chip, &msgs[i]);
+			if (err)
+				return err;
+		}
+	}
+
+	return num;
+}
+
+static u32 xfmc_sim_func(struct i2c_adapter *adap)
+{
+	return I2C_FUNC_I2C | I2C_FUNC_SMBUS_EMUL;
+}
+
+static const struct i2c_algorithm xfmc_sim_algo = {
+	.master_xfer = xfmc_sim_xfer,
+	.functionality = xfmc_sim_func,
+};
+
+static struct i2c_adapter xfmc_sim_adapter = {
+	.owner = THIS_MODULE,
+	.algo = &xfmc_sim_algo,
+	.name = "xfmc-i2c-sim",
+};
+
+static int xfmc_sim_regs_show(struct seq_file *m, void *data)
+{
+	struct xfmc_sim_chip *chip = m->private;
+	unsigned long reg;
+	void *entry;
+
+	xa_for_each(&chip->regs, reg, entry)
+		seq_printf(m, "%0*lx %0*lx\n", chip->reg_bytes * 2, reg,
+			   chip->val_bytes * 2, xa_to_value(entry));
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(xfmc_sim_regs);
+
+static void xfmc_sim_remove_clients(void)
+{
+	int i;
+
+	for (i = ARRAY_SIZE(xfmc_sim_chips) - 1; i >= 0; i--) {
+		i2c_unregister_device(xfmc_sim_chips[i].client);
+		xfmc_sim_chips[i].client = NULL;
+	}
+}
+
+static int __init xfmc_sim_init(void)
+{
+	struct i2c_board_info info = {};
+	struct xfmc_sim_chip *chip;
+	int i, err;
+
+	BUILD_BUG_ON(BITS_PER_LONG < 64);
+
+	for (i = 0; i < ARRAY_SIZE(xfmc_sim_chips); i++)
+		xa_init(&xfmc_sim_chips[i].regs);
+
+	/* the retimer holds off its init until it reports a known revision */
+	chip = xfmc_sim_find(0x14);
+	err = xa_err(xa_store(&chip->regs, XFMC_SIM_MCDP6000_REG_REV,
+			      xa_mk_value(swab32(mcdp6000_rev)), GFP_KERNEL));
+	if (err)
+		goto err_regs;
+
+	err = i2c_add_adapter(&xfmc_sim_adapter);
+	if (err)
+		goto err_regs;
+
+	xfmc_sim_debugfs = debugfs_create_dir("xfmc-i2c-sim", NULL);
+
+	for (i = 0; i < ARRAY_SIZE(xfmc_sim_chips); i++) {
+		char name[24];
+
+		chip = &xfmc_sim_chips[i];
+		strscpy(info.type, chip->name, sizeof(info.type));
+		info.addr = chip->addr;
+		chip->client = i2c_new_client_device(&xfmc_sim_adapter, &info);
+		if (IS_ERR(chip->client)) {
+			err = PTR_ERR(chip->client);
+			chip->client = NULL;
+			goto err_clients;
+		}
+
+		snprintf(name, sizeof(name), "%02x-%s", chip->addr, chip->name);
+		debugfs_create_file(name, 0400, xfmc_sim_debugfs, chip,
+				    &xfmc_sim_regs_fops);
+	}
+
+	/* all devices are in place, let the bring-up run */
+	xfmc_sim_pdev = platform_device_register_simple("xilinx-vfmc",
+							PLATFORM_DEVID_NONE,
+							NULL, 0);
+	if (IS_ERR(xfmc_sim_pdev)) {
+		err = PTR_ERR(xfmc_sim_pdev);
+		goto err_clients;
+	}
+
+	return 0;
+
+err_clients:
+	xfmc_sim_remove_clients();
+	debugfs_remove_recursive(xfmc_sim_debugfs);
+	i2c_del_adapter(&xfmc_sim_adapter);
+err_regs:
+	for (i = 0; i < ARRAY_SIZE(xfmc_sim_chips); i++)
+		xa_destroy(&xfmc_sim_chips[i].regs);
+	return err;
+}
+module_init(xfmc_sim_init);
+
+static void __exit xfmc_sim_exit(void)
+{
+	int i;
+
+	platform_device_unregister(xfmc_sim_pdev);
+	xfmc_sim_remove_clients();
+	debugfs_remove_recursive(xfmc_sim_debugfs);
+	i2c_del_adapter(&xfmc_sim_adapter);
+	for (i = 0; i < ARRAY_SIZE(xfmc_sim_chips); i++)
+		xa_destroy(&xfmc_sim_chips[i].regs);
+}
+module_exit(xfmc_sim_exit);
+
+MODULE_LICENSE("GPL");
+MODULE_DESCRIPTION("Simulated I2C bus carrying the Video FMC devices");
@@ -15,6 +15,9 @@
 #include <linux/regmap.h>
 #include <linux/slab.h>
 
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
 /**************************** Type Definitions *******************************/
 
 struct reg_8 {
@@ -25,6 +28,7 @@ struct reg_8 {
 static const struct regmap_config tipower_regmap_config = {
 	.reg_bits = 8,
 	.val_bits = 8,
+	.cache_type = REGCACHE_RBTREE,
 };
 
 /*
@@ -32,12 +36,14 @@ static const struct regmap_config tipower_regmap_config = {
  * @client: Pointer to I2C client
  * @ctrls: tipower control structure
  * @regmap: Pointer to regmap structure
+ * @script: Init script replacing the built-in sequence, if any
  * @lock: Mutex structure
  * @mode_index: Resolution mode index
  */
 struct tipowers {
 	struct i2c_client *client;
 	struct regmap *regmap;
+	struct xfmc_script script;
 
 	/* mutex for serializing operations */
 	struct mutex lock;
@@ -46,11 +52,33 @@ struct tipowers {
 
 struct tipowers *tipower;
 
+#define TIPOWER_POWER_UP_DELAY_MS	20
+#define TIPOWER_VERIFY_RETRIES		3
+
+/* registers programmed by tipower_init(), all within one bulk read */
+#define TIPOWER_INIT_FIRST_REG		29
+#define TIPOWER_INIT_LAST_REG		56
+
+static const struct reg_sequence tipower_init_regs[] = {
+	{ 29, 0x3 },
+	{ 31, 0x0 },
+	{ 32, 0x0 },
+	{ 34, 0x0 },
+	{ 35, 0x0 },
+	{ 37, 0x0 },
+	{ 39, 0x0 },
+	{ 41, 0x0 },
+	{ 43, 0x0 },
+	{ 50, 0xf6 },
+	{ 56, 0x1 },
+};
+
 /*
  * Function declaration
  */
 static inline void msleep_range(unsigned int delay_base)
 {
+	xfmc_account_sleep(delay_base * 1000);
 	usleep_range(delay_base * 1000, delay_base * 1000 + 500);
 }
 
@@ -64,57 +92,87 @@ static inline int tipower_read_reg(struct tipowers *priv, u16 addr, u8 *val)
 	return err;
 }
 
-static inline int tipower_write_reg(struct tipowers *priv, u16 addr, u8 val)
+/*
+ * tipower_write_verify - write a register set and verify it
+ * @priv: tipower device
+ * @regs: registers to write, within [first, last]
+ * @num_regs: number of registers
+ * @first: first register covered by the verify read
+ * @last: last register covered by the verify read
+ *
+ * All registers are written as one batch and then read back from the device
+ * with a single bulk read, bypassing the register cache. Only registers that
+ * read back wrong are written again.
+ *
+ * Return: 0 on success, negative error code otherwise
+ */
+static int tipower_write_verify(struct tipowers *priv,
+				const struct reg_sequence *regs, int num_regs,
+				unsigned int first, unsigned int last)
 {
-	int err;
-	u32 rdval;
+	u8 rdval[TIPOWER_INIT_LAST_REG - TIPOWER_INIT_FIRST_REG + 1];
+	unsigned int mismatch;
+	int retry, i, err;
 
-	err = regmap_write(priv->regmap, addr, val);
-	if (err)
-		dev_dbg(&priv->client->dev, "tipower :regmap_write failed\n");
+	if (WARN_ON(last - first + 1 > sizeof(rdval)))
+		return -EINVAL;
 
-	err = regmap_read(priv->regmap, addr, &rdval);
+	err = regmap_multi_reg_write(priv->regmap, regs, num_regs);
 	if (err) {
 		dev_dbg(&priv->client->dev, "tipower :regmap_write failed\n");
+		return err;
 	}
 
-	dev_dbg(&priv->client->dev,
-		"reg_addr = 0x%x, wrval =0x%x, rdval = 0x%x\n",addr, val, rdval);
+	for (retry = 0; retry < TIPOWER_VERIFY_RETRIES; retry++) {
+		regcache_cache_bypass(priv->regmap, true);
+		err = regmap_bulk_read(priv->regmap, first, rdval,
+				       last - first + 1);
+		regcache_cache_bypass(priv->regmap, false);
+		if (err) {
+			dev_dbg(&priv->client->dev,
+				"tipower :regmap_read failed\n");
+			return err;
+		}
+
+		mismatch = 0;
+		for (i = 0; i < num_regs; i++) {
+			if (rdval[regs[i].reg - first] == regs[i].def)
+				continue;
+
+			dev_dbg(&priv->client->dev,
+				"reg_addr = 0x%x, wrval =0x%x, rdval = 0x%x\n",
+				regs[i].reg, regs[i].def,
+				rdval[regs[i].reg - first]);
+			mismatch++;
+			err = regmap_write(priv->regmap, regs[i].reg,
+					   regs[i].def);
+			if (err)
+				return err;
+		}
+
+		if (!mismatch)
+			return 0;
+	}
 
-	return err;
+	return -EIO;
 }
 
 int tipower_init(void)
 {
 	int ret = 0;
 
-	msleep_range(20);
-	ret = tipower_write_reg(tipower, 29, 0x3);
+	if (xfmc_script_loaded(&tipower->script))
+		return xfmc_script_run(&tipower->client->dev, tipower->regmap,
+				       &tipower->script, 0) ? 1 : 0;
+
+	msleep_range(TIPOWER_POWER_UP_DELAY_MS);
+	ret = tipower_write_verify(tipower, tipower_init_regs,
+				   ARRAY_SIZE(tipower_init_regs),
+				   TIPOWER_INIT_FIRST_REG,
+				   TIPOWER_INIT_LAST_REG);
 	if (ret)
 		return 1;
 
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 31, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 32, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 34, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 35, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 37, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 39, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 41, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 43, 0x0);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 50, 0xf6);
-	msleep_range(10);
-	ret = tipower_write_reg(tipower, 56, 0x1);
-	msleep_range(10);
-
 	return 0;
 }
 EXPORT_SYMBOL_GPL(tipower_init);
@@ -143,7 +201,7 @@ static int tipower_probe(struct i2c_client *client)
 	mutex_init(&tipower->lock);
 
 	/* initialize regmap */
-	tipower->regmap = devm_regmap_init_i2c(client, &tipower_regmap_config);
+	tipower->regmap = xfmc_regmap_init_i2c(client, &tipower_regmap_config);
 	if (IS_ERR(tipower->regmap)) {
 		dev_err(&client->dev,
 			"regmap init failed: %ld\n", PTR_ERR(tipower->regmap));
@@ -153,6 +211,8 @@ static int tipower_probe(struct i2c_client *client)
 
 	tipower->client = client;
 
+	xfmc_script_load(&client->dev, "tipower", &tipower->script);
+
 	dev_info(&client->dev, "tipower : probe success !\n");
 
 	return 0;
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Xilinx Video FMC I2C init script engine
+ *
+ * Copyright (C) 2020 Xilinx, Inc.
+ *
+ */
+#include <linux/delay.h>
+#include <linux/device.h>
+#include <linux/firmware.h>
+#include <linux/iopoll.h>
+#include <linux/module.h>
+#include <linux/of.h>
+#include <linux/regmap.h>
+#include <linux/slab.h>
+
+#include "xfmc_script.h"
+#include "xilinx-vfmc.h"
+
+/* longest run of adjacent writes sent as one bulk transfer */
+#define XFMC_SCRIPT_MAX_BURST	128
+#define XFMC_SCRIPT_POLL_US	100
+
+/*
+ * struct xfmc_script_burst - adjacent register writes waiting to go out
+ * @reg: first register
+ * @count: number of values
+ * @vals: values
+ * @buf: values in the register size, for regmap_bulk_write()
+ */
+struct xfmc_script_burst {
+	unsigned int reg;
+	unsigned int count;
+	u32 vals[XFMC_SCRIPT_MAX_BURST];
+	u8 buf[XFMC_SCRIPT_MAX_BURST * sizeof(u32)];
+};
+
+static int xfmc_script_check(struct device *dev, const u32 *words,
+			     size_t num_words)
+{
+	size_t i = 0;
+
+	while (i < num_words) {
+		if (num_words - i < XFMC_SCRIPT_OP_WORDS)
+			goto err;
+
+		switch (words[i]) {
+		case XFMC_SCRIPT_BULK:
+			if (words[i + 4] > num_words - i - XFMC_SCRIPT_OP_WORDS)
+				goto err;
+			i += words[i + 4];
+			break;
+		case XFMC_SCRIPT_POLL:
+			/* read_poll_timeout() would wait forever on 0 */
+			if (!words[i + 4])
+				goto err;
+			break;
+		case XFMC_SCRIPT_WRITE:
+		case XFMC_SCRIPT_MODIFY:
+		case XFMC_SCRIPT_DELAY:
+		case XFMC_SCRIPT_VERIFY:
+			break;
+		default:
+			goto err;
+		}
+
+		i += XFMC_SCRIPT_OP_WORDS;
+	}
+
+	return 0;
+
+err:
+	dev_err(dev, "invalid init script at word %zu\n", i);
+	return -EINVAL;
+}
+
+static int xfmc_script_load_fw(struct device *dev, const char *name,
+			       struct xfmc_script *script)
+{
+	const struct firmware *fw;
+	const __le32 *data;
+	char path[64];
+	size_t i;
+	int ret;
+
+	snprintf(path, sizeof(path), "xilinx/xfmc/%s.bin", name);
+	ret = firmware_request_nowarn(&fw, path, dev);
+	if (ret)
+		return ret;
+
+	data = (const __le32 *)fw->data;
+	if (fw->size < sizeof(*data) || fw->size % sizeof(*data) ||
+	    le32_to_cpu(data[0]) != XFMC_SCRIPT_MAGIC) {
+		dev_err(dev, "%s: bad init script\n", path);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	script->num_words = fw->size / sizeof(*data) - 1;
+	script->words = devm_kmalloc_array(dev, script->num_words,
+					   sizeof(u32), GFP_KERNEL);
+	if (!script->words) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < script->num_words; i++)
+		script->words[i] = le32_to_cpu(data[i + 1]);
+
+	dev_info(dev, "init script %s\n", path);
+
+out:
+	release_firmware(fw);
+	return ret;
+}
+
+static int xfmc_script_load_of(struct device *dev, struct xfmc_script *script)
+{
+	int count;
+
+	count = of_property_count_u32_elems(dev->of_node, "xlnx,init-script");
+	if (count <= 0)
+		return -ENOENT;
+
+	script->words = devm_kmalloc_array(dev, count, sizeof(u32),
+					   GFP_KERNEL);
+	if (!script->words)
+		return -ENOMEM;
+
+	script->num_words = count;
+
+	return of_property_read_u32_array(dev->of_node, "xlnx,init-script",
+					  script->words, count);
+}
+
+/**
+ * xfmc_script_load - load the init script of a device
+ * @dev: device the script is for
+ * @name: firmware base name of the script
+ * @script: loaded script
+ *
+ * A firmware file takes precedence over the device tree property, so boards
+ * can ship a tuned sequence without touching the device tree.
+ *
+ * Return: 0 on success, -ENOENT if the device has no script, other negative
+ * error codes if the script is broken
+ */
+int xfmc_script_load(struct device *dev, const char *name,
+		     struct xfmc_script *script)
+{
+	int ret;
+
+	script->words = NULL;
+	script->num_words = 0;
+
+	ret = xfmc_script_load_fw(dev, name, script);
+	if (ret && ret != -EINVAL && ret != -ENOMEM)
+		ret = xfmc_script_load_of(dev, script);
+	if (!ret)
+		ret = xfmc_script_check(dev, script->words, script->num_words);
+	if (ret)
+		script->num_words = 0;
+
+	return ret;
+}
+EXPORT_SYMBOL_GPL(xfmc_script_load);
+
+static int xfmc_script_flush(struct regmap *regmap,
+			     struct xfmc_script_burst *burst)
+{
+	size_t val_bytes = regmap_get_val_bytes(regmap);
+	unsigned int count = burst->count;
+	void *buf = burst->buf;
+	unsigned int i;
+
+	burst->count = 0;
+
+	if (count == 1)
+		return regmap_write(regmap, burst->reg, burst->vals[0]);
+
+	/* regmap_bulk_write() takes values in the native register size */
+	for (i = 0; i < count; i++) {
+		switch (val_bytes) {
+		case 1:
+			((u8 *)buf)[i] = burst->vals[i];
+			break;
+		case 2:
+			((u16 *)buf)[i] = burst->vals[i];
+			break;
+		default:
+			((u32 *)buf)[i] = burst->vals[i];
+			break;
+		}
+	}
+
+	return regmap_bulk_write(regmap, burst->reg, buf, count);
+}
+
+static int xfmc_script_write(struct regmap *regmap,
+			     struct xfmc_script_burst *burst,
+			     unsigned int reg, u32 val, unsigned int flags)
+{
+	int ret = 0;
+
+	if (burst->count &&
+	    (!(flags & XFMC_SCRIPT_MERGE) ||
+	     burst->count == XFMC_SCRIPT_MAX_BURST ||
+	     reg != burst->reg +
+		    burst->count * regmap_get_reg_stride(regmap)))
+		ret = xfmc_script_flush(regmap, burst);
+
+	if (!burst->count)
+		burst->reg = reg;
+	burst->vals[burst->count++] = val;
+
+	return ret;
+}
+
+/* read from the device, the register caches hold what was last written */
+static int xfmc_script_read_dev(struct regmap *regmap, unsigned int reg,
+				unsigned int *val)
+{
+	int ret;
+
+	regcache_cache_bypass(regmap, true);
+	ret = regmap_read(regmap, reg, val);
+	regcache_cache_bypass(regmap, false);
+
+	return ret;
+}
+
+static int xfmc_script_poll(struct regmap *regmap, unsigned int reg,
+			    u32 val, u32 mask, u32 timeout_us)
+{
+	unsigned int rdval;
+	int err, ret;
+
+	ret = read_poll_timeout(xfmc_script_read_dev, err,
+				err || (rdval & mask) == val,
+				XFMC_SCRIPT_POLL_US, timeout_us, false,
+				regmap, reg, &rdval);
+
+	return ret ? ret : err;
+}
+
+static int xfmc_script_verify(struct regmap *regmap, unsigned int reg,
+			      u32 val, u32 mask)
+{
+	unsigned int rdval;
+	int ret;
+
+	ret = xfmc_script_read_dev(regmap, reg, &rdval);
+	if (ret)
+		return ret;
+
+	return (rdval & mask) == val ? 0 : -EIO;
+}
+
+/**
+ * xfmc_script_run - run an init script
+ * @dev: device, for diagnostics
+ * @regmap: register map of the device
+ * @script: script to run
+ * @flags: XFMC_SCRIPT_MERGE if adjacent writes may be merged
+ *
+ * Writes are held back while they address adjacent registers and go out as
+ * one bulk transfer when the run ends, any other operation ending it first.
+ *
+ * Return: 0 on success, negative error code otherwise
+ */
+int xfmc_script_run(struct device *dev, struct regmap *regmap,
+		    const struct xfmc_script *script, unsigned int flags)
+{
+	struct xfmc_script_burst *burst;
+	const u32 *op = NULL;
+	size_t i = 0;
+	u32 j;
+	int ret = 0;
+
+	burst = kzalloc(sizeof(*burst), GFP_KERNEL);
+	if (!burst)
+		return -ENOMEM;
+
+	while (!ret && i < script->num_words) {
+		op = &script->words[i];
+		i += XFMC_SCRIPT_OP_WORDS;
+
+		switch (op[0]) {
+		case XFMC_SCRIPT_WRITE:
+			ret = xfmc_script_write(regmap, burst, op[1], op[2],
+						flags);
+			continue;
+		case XFMC_SCRIPT_BULK:
+			for (j = 0; !ret && j < op[4]; j++)
+				ret = xfmc_script_write(regmap, burst,
+							op[1] + j *
+							regmap_get_reg_stride(regmap),
+							op[XFMC_SCRIPT_OP_WORDS + j],
+							flags | XFMC_SCRIPT_MERGE);
+			i += op[4];
+			continue;
+		}
+
+		if (burst->count) {
+			ret = xfmc_script_flush(regmap, burst);
+			if (ret)
+				break;
+		}
+
+		switch (op[0]) {
+		case XFMC_SCRIPT_MODIFY:
+			ret = regmap_update_bits(regmap, op[1], op[3], op[2]);
+			break;
+		case XFMC_SCRIPT_POLL:
+			ret = xfmc_script_poll(regmap, op[1], op[2], op[3],
+					       op[4]);
+			break;
+		case XFMC_SCRIPT_DELAY:
+			xfmc_account_sleep(op[4]);
+			fsleep(op[4]);
+			break;
+		case XFMC_SCRIPT_VERIFY:
+			ret = xfmc_script_verify(regmap, op[1], op[2], op[3]);
+			break;
+		}
+	}
+
+	if (!ret && burst->count)
+		ret = xfmc_script_flush(regmap, burst);
+
+	if (ret)
+		dev_err(dev, "init script failed at word %zu: %d\n",
+			(size_t)(op - script->words), ret);
+
+	kfree(burst);
+
+	return ret;
+}
+EXPORT_SYMBOL_GPL(xfmc_script_run);
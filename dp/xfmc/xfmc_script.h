@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Xilinx Video FMC I2C init script engine
+ *
+ * Copyright (C) 2020 Xilinx, Inc.
+ *
+ */
+#ifndef __XFMC_SCRIPT_H__
+#define __XFMC_SCRIPT_H__
+
+#include <linux/device.h>
+#include <linux/regmap.h>
+#include <linux/types.h>
+
+/*
+ * A script is a stream of 32-bit words. Every operation takes five words,
+ *	op, reg, val, mask, arg
+ * and a bulk write is followed by arg more words, one per register value.
+ *
+ * XFMC_SCRIPT_WRITE	reg = val
+ * XFMC_SCRIPT_BULK	reg, reg + 1, ... = the arg words that follow
+ * XFMC_SCRIPT_MODIFY	reg = (reg & ~mask) | (val & mask)
+ * XFMC_SCRIPT_POLL	wait until (reg & mask) == val, read from the device,
+ *			for arg us at most, arg must not be 0
+ * XFMC_SCRIPT_DELAY	sleep for arg us
+ * XFMC_SCRIPT_VERIFY	fail unless (reg & mask) == val, read from the device
+ *
+ * Scripts come from the firmware file xilinx/xfmc/<name>.bin, little endian
+ * words after the XFMC_SCRIPT_MAGIC word, or else from the
+ * "xlnx,init-script" u32 array property of the device node.
+ */
+enum xfmc_script_opcode {
+	XFMC_SCRIPT_WRITE = 1,
+	XFMC_SCRIPT_BULK,
+	XFMC_SCRIPT_MODIFY,
+	XFMC_SCRIPT_POLL,
+	XFMC_SCRIPT_DELAY,
+	XFMC_SCRIPT_VERIFY,
+};
+
+#define XFMC_SCRIPT_MAGIC	0x534d4658	/* "XFMS" */
+#define XFMC_SCRIPT_OP_WORDS	5
+
+/* the device auto-increments, adjacent writes may become one transfer */
+#define XFMC_SCRIPT_MERGE	BIT(0)
+
+/*
+ * struct xfmc_script - init script of a device
+ * @words: script words in host byte order
+ * @num_words: number of words, 0 if the device has no script
+ */
+struct xfmc_script {
+	u32 *words;
+	size_t num_words;
+};
+
+static inline bool xfmc_script_loaded(const struct xfmc_script *script)
+{
+	return script->num_words != 0;
+}
+
+int xfmc_script_load(struct device *dev, const char *name,
+		     struct xfmc_script *script);
+int xfmc_script_run(struct device *dev, struct regmap *regmap,
+		    const struct xfmc_script *script, unsigned int flags);
+
+#endif /* __XFMC_SCRIPT_H__ */
@@ -7,8 +7,12 @@
 #define DEBUG
 #define DEBUG_TRACE
 
+#include <linux/async.h>
 #include <linux/clk.h>
+#include <linux/completion.h>
+#include <linux/debugfs.h>
 #include <linux/delay.h>
+#include <linux/i2c.h>
 #include <linux/io.h>
 #include <linux/kernel.h>
 #include <linux/module.h>
@@ -23,6 +27,13 @@
 #include <linux/list.h>
 #include <linux/slab.h>
 #include <linux/interrupt.h>
+#include <linux/ktime.h>
+#include <linux/mutex.h>
+#include <linux/sched.h>
+#include <linux/seq_file.h>
+#include <linux/uaccess.h>
+
+#include "xilinx-vfmc.h"
 
 #define VERSAL_HPC0	0x4
 #define ZYNQMP_HPC0	0x7
@@ -41,16 +52,16 @@ int fmc_entry(void);
 void fmc_exit(void);
 
 int fmc64_entry(void);
-int fmc64_exit(void);
+void fmc64_exit(void);
 
 int fmc65_entry(void);
-int fmc65_exit(void);
+void fmc65_exit(void);
 
 int tipower_entry(void);
 void tipower_exit(void);
 
 int dp141_entry(void);
-int dp141_exit(void);
+void dp141_exit(void);
 
 int mcdp6000_entry(void);
 void mcdp6000_exit(void);
@@ -66,6 +77,7 @@ int mcdp6000_rst_cr_path_callback(void);
 
 struct x_vfmc_dev {
 	struct device *dev;
+	struct dentry *debugfs;
 };
 
 static void xvfmc_retimer_prbs_mode(u8 enable)
@@ -102,56 +114,348 @@ static struct x_vfmc_cfg retimer_ops = {
 	.retimer_set_prbs_mode = xvfmc_retimer_prbs_mode,
 };
 
-int xfmc_init(u8 hpc_connector)
+/*
+ * Bring-up graph of the FMC peripherals. Everything sits behind the I2C mux,
+ * the expanders gate power and resets of the other devices, the retimer and
+ * the redriver need the TI power rails, and the retimer also needs the IDT
+ * reference clock. Devices whose dependencies are met are brought up
+ * concurrently, so the total time approaches the critical path.
+ */
+enum xfmc_node_id {
+	XFMC_MUX,
+	XFMC_EXPANDER0,
+	XFMC_EXPANDER1,
+	XFMC_IDT,
+	XFMC_POWER,
+	XFMC_CLOCK,
+	XFMC_RETIMER,
+	XFMC_REDRIVER,
+	XFMC_NUM_NODES,
+};
+
+/*
+ * struct xfmc_node - one device of the bring-up graph
+ * @name: device, as reported
+ * @init: brings the device up
+ * @deps: nodes that have to be up first
+ * @done: completed when the device is up
+ * @task: thread running @init, to charge sleeps to the node
+ * @time_us: wall time of @init
+ * @sleep_us: time @init asked to sleep, the rest went to I2C transfers
+ * @xfers: I2C transfers @init made through its regmap
+ * @bytes: bytes those transfers carried, register addresses included
+ * @status: result of @init
+ */
+struct xfmc_node {
+	const char *name;
+	int (*init)(void);
+	unsigned long deps;
+	struct completion done;
+	struct task_struct *task;
+	s64 time_us;
+	unsigned long sleep_us;
+	unsigned long xfers;
+	unsigned long bytes;
+	int status;
+};
+
+static u8 xfmc_hpc_connector;
+static s64 xfmc_total_us;
+/* serializes bring-up runs */
+static DEFINE_MUTEX(xfmc_bringup_lock);
+
+static int xfmc_mux_init(void)
+{
+	return fmc_init(xfmc_hpc_connector);
+}
+
+static int xfmc_clock_init(void)
 {
-	unsigned int Status=1;
-
-	/* Platform Initialization */
-	fmc_entry();
-	fmc64_entry();
-	fmc65_entry();
-	tipower_entry();
-	dp141_entry();
-	mcdp6000_entry();
-	Status = fmc_init(hpc_connector);
-	if(Status)
-		printk("vphy: @75 selection HPC FMC failed\n");
-	Status = fmc64_init();
-        if(Status)
-                printk("vphy: @64 Configure VFMC IO Expander 0 failed\n");
-	Status = fmc65_init();
-	if(Status)
-		printk("vphy: @65 Configure VFMC IO Expander 1 failed\n");
-
-	idt_init();
-	Status = IDT_8T49N24x_Init();
-	if(Status)
-		printk("vphy: @7C IDT init failed\n");
-
-	Status = tipower_init();
-	if(Status)
-		printk("vphy: @50  TI POWER config failed\n");
-
-	Status = IDT_8T49N24x_SetClock();
-	if(Status)
-		printk("vphy: @7C IDT set clock failed\n");
-
-	Status = IDT_8T49N24x_Configure();
-	if(Status)
-	printk("vphy: @7C IDT configure failed\n");
-			Status = mcdp6000_init();
-        if(Status)
-                printk("vphy: @14  MCDP6000 init failed\n");
-
-	Status = dp141_init();
-	if(Status)
-		printk("vphy: @05  dp141 config failed\n");
+	int ret;
+
+	ret = IDT_8T49N24x_SetClock();
+	if (ret)
+		return ret;
+
+	return IDT_8T49N24x_Configure();
+}
+
+static struct xfmc_node xfmc_nodes[XFMC_NUM_NODES] = {
+	[XFMC_MUX] = {
+		.name = "@75 selection HPC FMC",
+		.init = xfmc_mux_init,
+	},
+	[XFMC_EXPANDER0] = {
+		.name = "@64 Configure VFMC IO Expander 0",
+		.init = fmc64_init,
+		.deps = BIT(XFMC_MUX),
+	},
+	[XFMC_EXPANDER1] = {
+		.name = "@65 Configure VFMC IO Expander 1",
+		.init = fmc65_init,
+		.deps = BIT(XFMC_MUX),
+	},
+	[XFMC_IDT] = {
+		.name = "@7C IDT init",
+		.init = IDT_8T49N24x_Init,
+		.deps = BIT(XFMC_EXPANDER0) | BIT(XFMC_EXPANDER1),
+	},
+	[XFMC_POWER] = {
+		.name = "@50  TI POWER config",
+		.init = tipower_init,
+		.deps = BIT(XFMC_EXPANDER0) | BIT(XFMC_EXPANDER1),
+	},
+	[XFMC_CLOCK] = {
+		.name = "@7C IDT set clock",
+		.init = xfmc_clock_init,
+		.deps = BIT(XFMC_IDT) | BIT(XFMC_POWER),
+	},
+	[XFMC_RETIMER] = {
+		.name = "@14  MCDP6000 init",
+		.init = mcdp6000_init,
+		.deps = BIT(XFMC_POWER) | BIT(XFMC_CLOCK),
+	},
+	[XFMC_REDRIVER] = {
+		.name = "@05  dp141 config",
+		.init = dp141_init,
+		.deps = BIT(XFMC_POWER),
+	},
+};
 
+static ASYNC_DOMAIN_EXCLUSIVE(xfmc_async_domain);
+
+static void xfmc_node_run(void *data, async_cookie_t cookie)
+{
+	struct xfmc_node *node = data;
+	ktime_t start;
+	int i;
+
+	for_each_set_bit(i, &node->deps, XFMC_NUM_NODES)
+		wait_for_completion(&xfmc_nodes[i].done);
+
+	node->sleep_us = 0;
+	node->xfers = 0;
+	node->bytes = 0;
+	WRITE_ONCE(node->task, current);
+
+	start = ktime_get();
+	node->status = node->init();
+	node->time_us = ktime_us_delta(ktime_get(), start);
+
+	WRITE_ONCE(node->task, NULL);
+	complete_all(&node->done);
+}
+
+static struct xfmc_node *xfmc_current_node(void)
+{
+	int i;
+
+	for (i = 0; i < XFMC_NUM_NODES; i++)
+		if (READ_ONCE(xfmc_nodes[i].task) == current)
+			return &xfmc_nodes[i];
+
+	return NULL;
+}
+
+void xfmc_account_sleep(unsigned long us)
+{
+	struct xfmc_node *node = xfmc_current_node();
+
+	if (node)
+		node->sleep_us += us;
+}
+EXPORT_SYMBOL_GPL(xfmc_account_sleep);
+
+static void xfmc_account_xfer(size_t bytes)
+{
+	struct xfmc_node *node = xfmc_current_node();
+
+	if (node) {
+		node->xfers++;
+		node->bytes += bytes;
+	}
+}
+
+/*
+ * Plain I2C regmap bus, as regmap-i2c uses on I2C capable adapters, that
+ * charges each transfer to the device being brought up.
+ */
+static int xfmc_i2c_write(void *context, const void *data, size_t count)
+{
+	struct i2c_client *client = context;
+	int ret;
+
+	ret = i2c_master_send(client, data, count);
+	xfmc_account_xfer(count);
+	if (ret == count)
+		return 0;
+
+	return ret < 0 ? ret : -EIO;
+}
+
+static int xfmc_i2c_read(void *context, const void *reg, size_t reg_size,
+			 void *val, size_t val_size)
+{
+	struct i2c_client *client = context;
+	struct i2c_msg xfer[2] = {
+		{
+			.addr = client->addr,
+			.len = reg_size,
+			.buf = (u8 *)reg,
+		}, {
+			.addr = client->addr,
+			.flags = I2C_M_RD,
+			.len = val_size,
+			.buf = val,
+		},
+	};
+	int ret;
+
+	ret = i2c_transfer(client->adapter, xfer, ARRAY_SIZE(xfer));
+	xfmc_account_xfer(reg_size + val_size);
+	if (ret == ARRAY_SIZE(xfer))
+		return 0;
+
+	return ret < 0 ? ret : -EIO;
+}
+
+static const struct regmap_bus xfmc_i2c_bus = {
+	.write = xfmc_i2c_write,
+	.read = xfmc_i2c_read,
+};
+
+/**
+ * xfmc_regmap_init_i2c - register map of an FMC device, with accounting
+ * @client: I2C client of the device
+ * @config: register map configuration
+ *
+ * Return: register map, or an ERR_PTR() on failure
+ */
+struct regmap *xfmc_regmap_init_i2c(struct i2c_client *client,
+				    const struct regmap_config *config)
+{
+	const struct i2c_adapter_quirks *quirks = client->adapter->quirks;
+	struct regmap_bus *bus;
+
+	if (!i2c_check_functionality(client->adapter, I2C_FUNC_I2C))
+		return ERR_PTR(-ENOTSUPP);
+
+	if (!quirks || (!quirks->max_read_len && !quirks->max_write_len))
+		return devm_regmap_init(&client->dev, &xfmc_i2c_bus, client,
+					config);
+
+	bus = devm_kmemdup(&client->dev, &xfmc_i2c_bus, sizeof(*bus),
+			   GFP_KERNEL);
+	if (!bus)
+		return ERR_PTR(-ENOMEM);
+
+	bus->max_raw_read = quirks->max_read_len;
+	bus->max_raw_write = quirks->max_write_len;
+
+	return devm_regmap_init(&client->dev, bus, client, config);
+}
+EXPORT_SYMBOL_GPL(xfmc_regmap_init_i2c);
+
+static void xfmc_bringup(void)
+{
+	ktime_t start;
+	int i;
+
+	mutex_lock(&xfmc_bringup_lock);
+
+	for (i = 0; i < XFMC_NUM_NODES; i++)
+		init_completion(&xfmc_nodes[i].done);
+
+	start = ktime_get();
+	for (i = 0; i < XFMC_NUM_NODES; i++)
+		async_schedule_domain(xfmc_node_run, &xfmc_nodes[i],
+				      &xfmc_async_domain);
+	async_synchronize_full_domain(&xfmc_async_domain);
+
+	for (i = 0; i < XFMC_NUM_NODES; i++) {
+		if (xfmc_nodes[i].status)
+			printk("vphy: %s failed\n", xfmc_nodes[i].name);
+		pr_debug("vphy: %s took %lld us, %lu us asleep, %lu xfers, %lu bytes\n",
+			 xfmc_nodes[i].name, xfmc_nodes[i].time_us,
+			 xfmc_nodes[i].sleep_us, xfmc_nodes[i].xfers,
+			 xfmc_nodes[i].bytes);
+	}
+	xfmc_total_us = ktime_us_delta(ktime_get(), start);
+	pr_info("vphy: FMC init took %lld us\n", xfmc_total_us);
+
+	mutex_unlock(&xfmc_bringup_lock);
+}
+
+int xfmc_init(u8 hpc_connector)
+{
+	xfmc_hpc_connector = hpc_connector;
+	xfmc_bringup();
 
 	return 0;
 }
 EXPORT_SYMBOL_GPL(xfmc_init);
 
+/*
+ * debugfs "bringup": reading reports the last bring-up per device, writing
+ * "run" runs the bring-up again, e.g. to benchmark a new init script. That
+ * reprograms the whole card, so only do it with the video links stopped.
+ */
+static int xfmc_bringup_show(struct seq_file *m, void *data)
+{
+	int i;
+
+	mutex_lock(&xfmc_bringup_lock);
+	seq_printf(m, "%-34s %6s %10s %10s %6s %6s\n", "device", "status",
+		   "wall us", "sleep us", "xfers", "bytes");
+	for (i = 0; i < XFMC_NUM_NODES; i++)
+		seq_printf(m, "%-34s %6d %10lld %10lu %6lu %6lu\n",
+			   xfmc_nodes[i].name, xfmc_nodes[i].status,
+			   xfmc_nodes[i].time_us, xfmc_nodes[i].sleep_us,
+			   xfmc_nodes[i].xfers, xfmc_nodes[i].bytes);
+	seq_printf(m, "%-34s %6s %10lld\n", "total", "", xfmc_total_us);
+	mutex_unlock(&xfmc_bringup_lock);
+
+	return 0;
+}
+
+static int xfmc_bringup_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, xfmc_bringup_show, inode->i_private);
+}
+
+static ssize_t xfmc_bringup_write(struct file *file, const char __user *buf,
+				  size_t count, loff_t *ppos)
+{
+	char cmd[8];
+
+	if (count >= sizeof(cmd))
+		return -EINVAL;
+	if (copy_from_user(cmd, buf, count))
+		return -EFAULT;
+	cmd[count] = '\0';
+
+	if (!sysfs_streq(cmd, "run"))
+		return -EINVAL;
+
+	xfmc_bringup();
+
+	return count;
+}
+
+static const struct file_operations xfmc_bringup_fops = {
+	.owner = THIS_MODULE,
+	.open = xfmc_bringup_open,
+	.read = seq_read,
+	.write = xfmc_bringup_write,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+static void xfmc_debugfs_remove(void *data)
+{
+	debugfs_remove_recursive(data);
+}
+
 /**
  * xvfmc_probe - The device probe function for driver initialization.
  * @pdev: pointer to the platform device structure.
@@ -189,8 +493,18 @@ static int xvfmc_probe(struct platform_device *pdev)
 		dev_err(xfmcdev->dev,
 			"Xilinx Video FMC initialization failed\n");
 	
+	/*
+	 * Binding this device is the ready notification: consumers with a
+	 * device link to it probe only now.
+	 */
 	platform_set_drvdata(pdev, priv_data);
 
+	xfmcdev->debugfs = debugfs_create_dir(dev_name(&pdev->dev), NULL);
+	debugfs_create_file("bringup", 0600, xfmcdev->debugfs, NULL,
+			    &xfmc_bringup_fops);
+	devm_add_action_or_reset(&pdev->dev, xfmc_debugfs_remove,
+				 xfmcdev->debugfs);
+
 	return 0;
 }
 
@@ -208,7 +522,74 @@ static struct platform_driver xvfmc_driver = {
 		.of_match_table	= xvfmc_of_match,
 	},
 };
-module_platform_driver(xvfmc_driver);
+
+static int __init xvfmc_module_init(void)
+{
+	int ret;
+
+	/*
+	 * The FMC devices bind on their own, ahead of the bring-up, rather
+	 * than from within the platform probe.
+	 */
+	ret = fmc_entry();
+	if (ret)
+		return ret;
+	ret = fmc64_entry();
+	if (ret)
+		goto err_fmc64;
+	ret = fmc65_entry();
+	if (ret)
+		goto err_fmc65;
+	ret = idt_init();
+	if (ret)
+		goto err_idt;
+	ret = tipower_entry();
+	if (ret)
+		goto err_tipower;
+	ret = dp141_entry();
+	if (ret)
+		goto err_dp141;
+	ret = mcdp6000_entry();
+	if (ret)
+		goto err_mcdp6000;
+
+	ret = platform_driver_register(&xvfmc_driver);
+	if (ret)
+		goto err_platform;
+
+	return 0;
+
+err_platform:
+	mcdp6000_exit();
+err_mcdp6000:
+	dp141_exit();
+err_dp141:
+	tipower_exit();
+err_tipower:
+	idt_exit();
+err_idt:
+	fmc65_exit();
+err_fmc65:
+	fmc64_exit();
+err_fmc64:
+	fmc_exit();
+	return ret;
+}
+module_init(xvfmc_module_init);
+
+static void __exit xvfmc_module_exit(void)
+{
+	platform_driver_unregister(&xvfmc_driver);
+
+	mcdp6000_exit();
+	dp141_exit();
+	tipower_exit();
+	idt_exit();
+	fmc65_exit();
+	fmc64_exit();
+	fmc_exit();
+}
+module_exit(xvfmc_module_exit);
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("Leon Woestenberg <leon@sidebranch.com>");
@@ -0,0 +1,20 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+/*
+ * Xilinx Video FMC bring-up
+ *
+ * Copyright (C) 2020 Xilinx, Inc.
+ *
+ */
+#ifndef __XILINX_VFMC_H__
+#define __XILINX_VFMC_H__
+
+#include <linux/i2c.h>
+#include <linux/regmap.h>
+
+/* charge a sleep to the FMC device being brought up by the calling thread */
+void xfmc_account_sleep(unsigned long us);
+/* regmap for an FMC device whose transfers are charged the same way */
+struct regmap *xfmc_regmap_init_i2c(struct i2c_client *client,
+				    const struct regmap_config *config);
+
+#endif /* __XILINX_VFMC_H__ */